@@ -46,10 +46,11 @@ typedef enum libhat_alignment {
 } libhat_alignment;
 
 typedef enum libhat_hint {
-    libhat_hint_none    = 0,
-    libhat_hint_x86_64  = 1 << 0,
-    libhat_hint_pair0   = 1 << 1,
-    libhat_hint_aarch64 = 1 << 2,
+    libhat_hint_none            = 0,
+    libhat_hint_x86_64          = 1 << 0,
+    libhat_hint_pair0           = 1 << 1,
+    libhat_hint_aarch64         = 1 << 2,
+    libhat_hint_adaptive_anchor = 1 << 3,
 } libhat_hint;
 
 typedef enum libhat_protection {
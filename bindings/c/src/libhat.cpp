@@ -54,7 +54,7 @@ namespace {
     }
 }
 
-struct libhat_signature final : libhat_ffi_wrapper<libhat_signature, hat::signature> {
+struct libhat_signature final : libhat_ffi_wrapper<libhat_signature, hat::small_signature<>> {
     using libhat_ffi_wrapper::libhat_ffi_wrapper;
     static constexpr uint32_t type_id = 0xFD19C2B3;
 };
@@ -108,7 +108,7 @@ LIBHAT_API const char* libhat_status_to_string(const libhat_status status) {
 }
 
 LIBHAT_API libhat_status libhat_parse_signature(const char* signatureStr, const libhat_signature** signatureOut) {
-    auto result = hat::parse_signature(signatureStr);
+    auto result = hat::parse_signature<>(signatureStr);
     if (!result.has_value()) {
         *signatureOut = nullptr;
         switch (result.error()) {
@@ -141,7 +141,7 @@ LIBHAT_API libhat_status libhat_create_signature(
         return libhat_err_sig_empty_signature;
     }
 
-    hat::signature signature{};
+    hat::small_signature<> signature{};
     bool containsByte = false;
     signature.reserve(size);
     for (size_t i{}; i < size; i++) {
@@ -1,21 +1,34 @@
 #pragma once
 
 #include "libhat/access.hpp"
+#include "libhat/batch.hpp"
+#include "libhat/calibration.hpp"
 #include "libhat/concepts.hpp"
 #include "libhat/cow.hpp"
 #include "libhat/cstring_view.hpp"
 #include "libhat/defines.hpp"
+#include "libhat/elf_image.hpp"
 #include "libhat/fixed_string.hpp"
+#include "libhat/hash.hpp"
 #include "libhat/memory.hpp"
 #include "libhat/memory_protector.hpp"
+#include "libhat/module_index.hpp"
+#include "libhat/pe_image.hpp"
+#include "libhat/pointers.hpp"
 #include "libhat/process.hpp"
+#include "libhat/registry.hpp"
 #include "libhat/result.hpp"
+#include "libhat/rtti.hpp"
+#include "libhat/scan_cache.hpp"
 #include "libhat/scanner.hpp"
 #include "libhat/signature.hpp"
+#include "libhat/signature_db.hpp"
+#include "libhat/signature_list.hpp"
 #include "libhat/strconv.hpp"
 #include "libhat/string_literal.hpp"
 #include "libhat/system.hpp"
 #include "libhat/type_traits.hpp"
 #include "libhat/utility.hpp"
+#include "libhat/xref.hpp"
 
 #include "libhat/experimental.hpp"
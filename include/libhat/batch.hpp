@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+#include "process.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    /// A single signature to be resolved by resolve_all
+    struct scan_request {
+        signature_view signature{};
+        std::string_view section{};
+        scan_alignment alignment = scan_alignment::X1;
+        scan_hint hints = scan_hint::none;
+    };
+
+    struct batch_options {
+        std::size_t threads{};    // The number of threads to scan with, zero to use one per physical core
+        std::size_t block_size{}; // The number of bytes each request is scanned over at once, zero to fit the L2 cache
+    };
+
+    /// Resolves many independent signatures at once. The sections they target are split into blocks that fit in the
+    /// L2 cache, and every request is scanned over a block while it's still cached, instead of streaming the whole
+    /// section from memory once per signature. Blocks are spread across a pool of threads. The results are in the
+    /// same order as the requests, and are the same as the ones of find_pattern with the request's arguments.
+    [[nodiscard]] std::vector<scan_result> resolve_all(
+        std::span<const scan_request> requests,
+        const process::module&        mod = process::get_process_module(),
+        const batch_options&          options = {}
+    );
+}
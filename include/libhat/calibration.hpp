@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <array>
+    #include <cstddef>
+    #include <filesystem>
+    #include <optional>
+    #include <string>
+#endif
+
+#include "export.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    /// The fastest scan mode for each buffer size class, as measured on a specific CPU
+    struct scan_calibration {
+        std::string cpu{}; // Empty if the CPU couldn't be identified
+        std::array<scan_mode, scan_size_class_count> modes{};
+    };
+
+    /// The amount of data scanned by calibrate_scan_modes per measurement by default
+    inline constexpr std::size_t default_calibration_bytes = std::size_t{16} << 20;
+
+    /// Benchmarks every supported scan mode on a buffer of each size class and returns the fastest ones. This takes
+    /// up to a few hundred milliseconds, so the result should be cached with save_scan_calibration. Smaller buffers are
+    /// scanned repeatedly until "bytes" are covered, and buffers larger than that are cut down to it, which trades
+    /// accuracy for time.
+    [[nodiscard]] scan_calibration calibrate_scan_modes(std::size_t bytes = default_calibration_bytes);
+
+    /// Sets the calibrated modes as the preferred scan modes
+    void apply_scan_calibration(const scan_calibration& calibration);
+
+    /// Writes the calibration to a file. Returns false if the file couldn't be written, or if the CPU it was made on
+    /// couldn't be identified.
+    bool save_scan_calibration(const scan_calibration& calibration, const std::filesystem::path& path);
+
+    /// Reads a calibration from a file. Returns std::nullopt if the file is missing or invalid, or if it was made on a
+    /// different CPU than the host.
+    [[nodiscard]] std::optional<scan_calibration> load_scan_calibration(const std::filesystem::path& path);
+
+    /// Opts into calibration the first time scan_mode::Auto picks a scanner. If a cache path is given, a calibration
+    /// for the host CPU is loaded from it instead when available, and a new calibration is saved to it otherwise. The
+    /// cache is ignored if the host CPU can't be identified.
+    /// Should be called before any scan, only the first call has an effect.
+    void enable_scan_calibration(std::filesystem::path cache = {});
+}
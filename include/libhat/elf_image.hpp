@@ -0,0 +1,142 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <cstdint>
+    #include <filesystem>
+    #include <functional>
+    #include <memory>
+    #include <optional>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+#include "memory.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    enum class elf_type : std::uint16_t {
+        none          = 0, // ET_NONE
+        relocatable   = 1, // ET_REL
+        executable    = 2, // ET_EXEC
+        shared_object = 3, // ET_DYN, including position independent executables
+        core          = 4, // ET_CORE
+    };
+
+    struct elf_section {
+        std::string_view name{};
+        std::uint64_t virtual_address{}; // 0 if the section isn't loaded
+        std::span<const std::byte> data{}; // Empty for sections without data in the file, such as .bss
+        hat::protection protection{};
+    };
+
+    /// A PT_LOAD segment. In core files, these are the memory mappings of the process which were dumped.
+    struct elf_segment {
+        std::uint64_t virtual_address{};
+        std::uint64_t memory_size{};
+        std::span<const std::byte> data{}; // The part which is in the file, from the start of the segment
+        hat::protection protection{};
+    };
+
+    /// An ELF file (executable, shared object or core dump) read from disk without loading it, which is memory mapped
+    /// so nothing is read until it is scanned. Section and segment data is in the layout of the file, results are
+    /// converted to the virtual addresses of the file with @code address_of@endcode. For executables and shared objects
+    /// these are relative to the load address if they're position independent, and for core files they are the
+    /// addresses in the process which was dumped. The views returned by the image point into its data, and stay valid
+    /// as long as a copy of the image exists. Only little endian files are supported.
+    class elf_image {
+    public:
+        /// Memory maps an ELF file. Returns std::nullopt if the file is missing or isn't a valid ELF file.
+        [[nodiscard]] static std::optional<elf_image> open(const std::filesystem::path& path);
+
+        /// Uses an ELF file in memory without copying it. The data must outlive the image. Returns std::nullopt if it
+        /// isn't a valid ELF file.
+        [[nodiscard]] static std::optional<elf_image> from_bytes(std::span<const std::byte> data);
+
+        /// Returns the contents of the file
+        [[nodiscard]] std::span<const std::byte> data() const noexcept {
+            return this->file;
+        }
+
+        [[nodiscard]] elf_type type() const noexcept {
+            return this->fileType;
+        }
+
+        /// Returns the e_machine field of the header, i.e. 62 (EM_X86_64) or 183 (EM_AARCH64)
+        [[nodiscard]] std::uint16_t machine() const noexcept {
+            return this->machineType;
+        }
+
+        /// Returns true for ELFCLASS64 files
+        [[nodiscard]] bool is_64bit() const noexcept {
+            return this->class64;
+        }
+
+        /// Returns the section table, in the order of the file. Core files usually don't have one.
+        [[nodiscard]] std::span<const elf_section> sections() const noexcept {
+            return this->sectionTable;
+        }
+
+        /// Returns the PT_LOAD segments, in the order of the file
+        [[nodiscard]] std::span<const elf_segment> segments() const noexcept {
+            return this->segmentTable;
+        }
+
+        /// Returns the data of the first section with the given name, or an empty span if there isn't one
+        [[nodiscard]] std::span<const std::byte> get_section_data(std::string_view name) const;
+
+        /// Invokes the callback for each section as long as it returns true, the same as
+        /// @code hat::process::module::for_each_section@endcode
+        void for_each_section(const std::function<bool(std::string_view name, std::span<const std::byte>, hat::protection)>& callback) const;
+
+        /// Invokes the callback for the file data of each PT_LOAD segment as long as it returns true, the same as
+        /// @code hat::process::module::for_each_segment@endcode
+        void for_each_segment(const std::function<bool(std::span<const std::byte>, hat::protection)>& callback) const;
+
+        /// Returns the file offset of a virtual address, or std::nullopt if it isn't backed by the file
+        [[nodiscard]] std::optional<std::size_t> address_to_offset(std::uint64_t address) const noexcept;
+
+        /// Returns the virtual address of a file offset, or std::nullopt if it isn't part of a loaded segment
+        [[nodiscard]] std::optional<std::uint64_t> offset_to_address(std::size_t offset) const noexcept;
+
+        /// Returns the virtual address of a pointer into the data of the image, such as a scan result
+        [[nodiscard]] std::optional<std::uint64_t> address_of(const std::byte* address) const noexcept {
+            if (address < this->file.data() || address >= this->file.data() + this->file.size()) {
+                return std::nullopt;
+            }
+            return this->offset_to_address(static_cast<std::size_t>(address - this->file.data()));
+        }
+
+    private:
+        elf_image(std::shared_ptr<const void> owner, std::span<const std::byte> file)
+            : owner(std::move(owner)), file(file) {}
+
+        [[nodiscard]] bool parse();
+
+        template<typename Layout>
+        [[nodiscard]] bool parse();
+
+        std::shared_ptr<const void> owner{};
+        std::span<const std::byte> file{};
+        elf_type fileType{};
+        std::uint16_t machineType{};
+        bool class64{};
+        std::vector<elf_section> sectionTable{};
+        std::vector<elf_segment> segmentTable{};
+    };
+
+    /// Perform a signature scan on a specific section of an ELF image
+    [[nodiscard]] inline const_scan_result find_pattern(
+        const signature_view   signature,
+        const std::string_view section,
+        const elf_image&       image,
+        const scan_alignment   alignment = scan_alignment::X1,
+        const scan_hint        hints = scan_hint::none
+    ) noexcept {
+        const auto data = image.get_section_data(section);
+        return find_pattern(data.begin(), data.end(), signature, alignment, hints);
+    }
+}
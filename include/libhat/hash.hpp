@@ -0,0 +1,16 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstdint>
+    #include <span>
+#endif
+
+#include "export.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    /// Computes the CRC-32C (Castagnoli) checksum of the data, using the CRC32 instructions of SSE 4.2 or ARMv8 when
+    /// available. A previous checksum can be passed to continue it, such that crc32c(b, crc32c(a)) is the checksum of
+    /// a followed by b.
+    [[nodiscard]] std::uint32_t crc32c(std::span<const std::byte> data, std::uint32_t crc = 0);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <cstdint>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+#include "process.hpp"
+#include "scanner.hpp"
+#include "signature.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    struct module_index_options {
+        std::size_t memory_budget{}; // The maximum size of the index in bytes, or 0 for no limit
+    };
+
+    /// An index of the 4 byte sequences in an immutable range of memory, for running many queries against the same
+    /// data. Queries look up the rarest sequence in the longest run of fully masked bytes of their signature, and only
+    /// compare the signature at the positions where it occurs.
+    ///
+    /// Every position is indexed unless that exceeds the memory budget, in which case only every Nth position is, and
+    /// the run has to be N - 1 bytes longer. Queries whose signature doesn't have a long enough run, and all queries if
+    /// the budget is too small for any index, scan the data instead.
+    class module_index {
+    public:
+        explicit module_index(std::span<const std::byte> data, const module_index_options& options = {});
+
+        /// Indexes a section of a module
+        module_index(const process::module& mod, std::string_view section, const module_index_options& options = {});
+
+        /// Same as find_pattern over the indexed data
+        [[nodiscard]] const_scan_result find_pattern(
+            signature_view signature,
+            scan_alignment alignment = scan_alignment::X1
+        ) const;
+
+        [[nodiscard]] std::span<const std::byte> data() const noexcept {
+            return this->bytes;
+        }
+
+        /// The distance between indexed positions, or 0 if nothing is indexed
+        [[nodiscard]] std::size_t stride() const noexcept {
+            return this->step;
+        }
+
+        /// The size of the index in bytes, excluding the data itself
+        [[nodiscard]] std::size_t memory_usage() const noexcept {
+            return (this->buckets.size() + this->positions.size()) * sizeof(std::uint32_t);
+        }
+
+    private:
+        [[nodiscard]] std::span<const std::uint32_t> lookup(std::uint32_t sequence) const noexcept;
+
+        std::span<const std::byte> bytes{};
+        std::size_t step{};
+        int bits{};
+        std::vector<std::uint32_t> buckets{};   // The range of positions of each hash bucket
+        std::vector<std::uint32_t> positions{}; // The indexed positions, ascending within each bucket
+    };
+}
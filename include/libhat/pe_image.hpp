@@ -0,0 +1,108 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <cstdint>
+    #include <filesystem>
+    #include <functional>
+    #include <memory>
+    #include <optional>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+#include "memory.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    struct pe_section {
+        std::string_view name{};
+        std::uint32_t virtual_address{}; // Relative to the image base
+        std::uint32_t virtual_size{};
+        std::span<const std::byte> data{}; // The raw data in the file, which may be shorter than the virtual size
+        hat::protection protection{};
+    };
+
+    /// A PE file (.exe, .dll, .sys) read from disk without loading it, so modules of any architecture can be scanned
+    /// on any platform. Section data is in the layout of the file rather than the layout in memory, relative virtual
+    /// addresses (RVAs) of results are found with @code offset_to_rva@endcode. The views returned by the image point
+    /// into its data, and stay valid as long as a copy of the image exists.
+    class pe_image {
+    public:
+        /// Memory maps a PE file. Returns std::nullopt if the file is missing or isn't a valid PE file.
+        [[nodiscard]] static std::optional<pe_image> open(const std::filesystem::path& path);
+
+        /// Uses a PE file in memory without copying it. The data must outlive the image. Returns std::nullopt if it
+        /// isn't a valid PE file.
+        [[nodiscard]] static std::optional<pe_image> from_bytes(std::span<const std::byte> data);
+
+        /// Returns the contents of the file
+        [[nodiscard]] std::span<const std::byte> data() const noexcept {
+            return this->file;
+        }
+
+        /// Returns the preferred base address from the optional header, which absolute addresses in the file assume
+        [[nodiscard]] std::uint64_t image_base() const noexcept {
+            return this->imageBase;
+        }
+
+        /// Returns true for PE32+ images, which have 64-bit absolute addresses
+        [[nodiscard]] bool is_64bit() const noexcept {
+            return this->pe32Plus;
+        }
+
+        /// Returns the section table, in the order of the file
+        [[nodiscard]] std::span<const pe_section> sections() const noexcept {
+            return this->sectionTable;
+        }
+
+        /// Returns the raw data of the first section with the given name, or an empty span if there isn't one
+        [[nodiscard]] std::span<const std::byte> get_section_data(std::string_view name) const;
+
+        /// Invokes the callback for each section as long as it returns true, the same as
+        /// @code hat::process::module::for_each_section@endcode
+        void for_each_section(const std::function<bool(std::string_view name, std::span<const std::byte>, hat::protection)>& callback) const;
+
+        /// Returns the file offset of a relative virtual address, or std::nullopt if it isn't backed by the file
+        [[nodiscard]] std::optional<std::size_t> rva_to_offset(std::uint32_t rva) const noexcept;
+
+        /// Returns the relative virtual address of a file offset, or std::nullopt if it isn't part of the image
+        [[nodiscard]] std::optional<std::uint32_t> offset_to_rva(std::size_t offset) const noexcept;
+
+        /// Returns the relative virtual address of a pointer into the data of the image, such as a scan result
+        [[nodiscard]] std::optional<std::uint32_t> rva_of(const std::byte* address) const noexcept {
+            if (address < this->file.data() || address >= this->file.data() + this->file.size()) {
+                return std::nullopt;
+            }
+            return this->offset_to_rva(static_cast<std::size_t>(address - this->file.data()));
+        }
+
+    private:
+        pe_image(std::shared_ptr<const void> owner, std::span<const std::byte> file)
+            : owner(std::move(owner)), file(file) {}
+
+        [[nodiscard]] bool parse();
+
+        std::shared_ptr<const void> owner{};
+        std::span<const std::byte> file{};
+        std::uint64_t imageBase{};
+        std::uint32_t sizeOfHeaders{};
+        bool pe32Plus{};
+        std::vector<pe_section> sectionTable{};
+    };
+
+    /// Perform a signature scan on a specific section of a PE image
+    [[nodiscard]] inline const_scan_result find_pattern(
+        const signature_view   signature,
+        const std::string_view section,
+        const pe_image&        image,
+        const scan_alignment   alignment = scan_alignment::X1,
+        const scan_hint        hints = scan_hint::none
+    ) noexcept {
+        const auto data = image.get_section_data(section);
+        return find_pattern(data.begin(), data.end(), signature, alignment, hints);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <cstdint>
+    #include <span>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    /// A range of addresses, excluding "end"
+    struct address_range {
+        std::uintptr_t begin{};
+        std::uintptr_t end{};
+
+        [[nodiscard]] constexpr bool contains(const std::uintptr_t address) const noexcept {
+            return address >= this->begin && address < this->end;
+        }
+
+        [[nodiscard]] constexpr auto operator<=>(const address_range&) const noexcept = default;
+    };
+
+    /// Returns the range of addresses covered by a region of memory
+    [[nodiscard]] inline address_range to_address_range(const std::span<const std::byte> region) noexcept {
+        const auto begin = reinterpret_cast<std::uintptr_t>(region.data());
+        return {begin, begin + region.size()};
+    }
+
+    /// Finds the pointer aligned values in "data" which are equal to "value". Each result points to a value. On 64-bit
+    /// targets, the values are compared a vector of lanes at a time.
+    [[nodiscard]] std::vector<const_scan_result> find_pointers(std::span<const std::byte> data, std::uintptr_t value);
+
+    /// Same as above, finding the values equal to any of a set of values, which must be sorted in ascending order. Up to
+    /// 4 values are compared exactly. Larger sets are compared against the range between the lowest and highest value,
+    /// with each value in range being looked up in the set.
+    [[nodiscard]] std::vector<const_scan_result> find_pointers(std::span<const std::byte> data, std::span<const std::uintptr_t> values);
+
+    /// Same as above, finding the values within a range, such as any pointer into a section of a module
+    [[nodiscard]] std::vector<const_scan_result> find_pointers(std::span<const std::byte> data, address_range range);
+
+    /// Same as above, finding the values within any of a set of ranges, which must be sorted in ascending order and not
+    /// overlap. The values are compared against the range from the lowest to the highest address in the set, with each
+    /// value in range being looked up in the set.
+    [[nodiscard]] std::vector<const_scan_result> find_pointers(std::span<const std::byte> data, std::span<const address_range> ranges);
+}
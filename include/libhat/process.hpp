@@ -52,6 +52,15 @@ LIBHAT_EXPORT namespace hat::process {
         /// segment headers, and may not reflect the current virtual protections for the relevant memory pages.
         void for_each_segment(const std::function<bool(std::span<std::byte>, hat::protection)>& callback) const;
 
+        /// Returns the identifier the linker assigned to this build of the module. This is the NT_GNU_BUILD_ID note on
+        /// ELF platforms, the LC_UUID load command on Mach-O, and the GUID and age of the CodeView debug record, which
+        /// identify the matching PDB, on Windows. Empty if the module wasn't linked with one.
+        [[nodiscard]] std::span<const std::byte> build_id() const;
+
+        /// Returns the CRC32C checksum of a named section, or std::nullopt if there is no such section. Intended for
+        /// detecting whether a read-only section changed between builds of the module.
+        [[nodiscard]] std::optional<std::uint32_t> content_hash(std::string_view section) const;
+
         [[nodiscard]] bool operator==(const module& other) const noexcept {
             return this->address() == other.address();
         }
@@ -0,0 +1,129 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <atomic>
+    #include <chrono>
+    #include <cstddef>
+#endif
+
+#include "batch.hpp"
+#include "export.hpp"
+#include "fixed_string.hpp"
+#include "scan_cache.hpp"
+#include "scanner.hpp"
+#include "signature.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    /// Transforms for lazy_address, which turn the match of its signature into the address it refers to
+    struct match_address_t {
+        [[nodiscard]] constexpr std::byte* operator()(const scan_result result) const noexcept {
+            return result.get();
+        }
+    };
+
+    template<std::size_t Offset, std::size_t Remaining = 0>
+    struct rel_offset_t {
+        [[nodiscard]] constexpr std::byte* operator()(const scan_result result) const noexcept {
+            return result.rel(Offset, Remaining);
+        }
+    };
+
+    /// The address of the match itself
+    inline constexpr match_address_t match_address{};
+
+    /// The target of a relative address in the match, see scan_result::rel
+    template<std::size_t Offset, std::size_t Remaining = 0>
+    inline constexpr rel_offset_t<Offset, Remaining> rel_offset{};
+
+    struct registry_stats {
+        std::size_t resolved{}; // The number of registered signatures that were scanned for by this call
+        std::size_t missing{};  // How many of those weren't found
+        std::chrono::nanoseconds elapsed{};
+    };
+}
+
+LIBHAT_EXPORT namespace hat::detail {
+
+    /// An entry in the global registry of signatures. Entries register themselves on construction, and are never
+    /// unregistered, so they must have static storage duration.
+    struct registered_address {
+        registered_address(scan_request request, std::byte*(*transform)(scan_result));
+
+        registered_address(const registered_address&) = delete;
+        registered_address& operator=(const registered_address&) = delete;
+
+        scan_request request;
+        std::byte*(*transform)(scan_result);
+        std::byte* address{};
+        std::atomic<bool> resolved{};
+
+        [[nodiscard]] std::byte* get() {
+            if (!this->resolved.load(std::memory_order_acquire)) LIBHAT_UNLIKELY {
+                this->resolve();
+            }
+            return this->address;
+        }
+
+    private:
+        void resolve();
+    };
+}
+
+LIBHAT_EXPORT namespace hat {
+
+    /// Resolves every registered signature that hasn't been resolved yet, in a single call to resolve_all
+    registry_stats resolve_registered(const batch_options& options = {});
+
+    /// Same as resolve_registered, using the offsets in the cache where possible
+    registry_stats resolve_registered(scan_cache& cache, const batch_options& options = {});
+
+#ifdef LIBHAT_HAS_CONSTEXPR_RESULT
+    /// The address of a signature in a section of the process module, declared at compile time. Every lazy_address
+    /// registers its signature during static initialization, and the first access of any of them resolves all of the
+    /// registered signatures at once. resolve_registered can be called to do this at a specific point instead, such as
+    /// during startup. The address is nullptr if the signature wasn't found.
+    ///
+    ///     inline constexpr hat::lazy_address<"48 8B 05 ? ? ? ? 48 85 C0", ".text", hat::rel_offset<3>> gWorld{};
+    ///     auto* world = gWorld.as<World*>();
+    template<
+        fixed_string   Signature,
+        fixed_string   Section = ".text",
+        auto           Transform = match_address,
+        scan_alignment Alignment = scan_alignment::X1,
+        scan_hint      Hints = scan_hint::none
+    >
+    class lazy_address {
+    public:
+        constexpr lazy_address() noexcept {
+            // Odr-uses the entry, so that it's registered even if get() is never called
+            static_cast<void>(&entry);
+        }
+
+        [[nodiscard]] std::byte* get() const {
+            return entry.get();
+        }
+
+        template<typename T>
+        [[nodiscard]] T* as() const {
+            return reinterpret_cast<T*>(this->get());
+        }
+
+        [[nodiscard]] explicit operator bool() const {
+            return this->get() != nullptr;
+        }
+
+    private:
+        static constexpr auto signature = compile_signature<Signature>();
+
+        static std::byte* transform(const scan_result result) {
+            return Transform(result);
+        }
+
+        static inline detail::registered_address entry{
+            scan_request{signature, Section.to_view(), Alignment, Hints},
+            &transform
+        };
+    };
+#endif
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <optional>
+    #include <string_view>
+    #include <unordered_map>
+#endif
+
+#include "export.hpp"
+#include "pe_image.hpp"
+#include "process.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    struct rtti_entry {
+        std::byte* type_info{}; // The std::type_info object of the class
+        std::byte* vtable{};    // The address point of the primary vtable, which objects point to, or nullptr
+    };
+
+    /// An index of the Itanium C++ ABI type information of a module, as used by GCC and Clang outside of Windows, keyed
+    /// by mangled type name, i.e. "3Foo" or "N2ns3FooE". The read-only data sections of the module are swept once for
+    /// pointers into themselves. A type_info object is a pointer to its vtable followed by a pointer to its name, and
+    /// the primary vtable of a class is an offset of 0 followed by a pointer to its type_info. The index doesn't keep the
+    /// module loaded, and its names and pointers are only valid for as long as the module stays loaded.
+    class rtti_index {
+    public:
+        explicit rtti_index(const process::module& mod = process::get_process_module());
+
+        /// Returns the type information of a class by its mangled name, or std::nullopt if there is none
+        [[nodiscard]] std::optional<rtti_entry> find(std::string_view mangledName) const;
+
+        /// Returns the vtable of a class by its mangled name, or nullptr if there is none
+        [[nodiscard]] scan_result find_vtable(std::string_view mangledName) const;
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return this->entries.size();
+        }
+
+    private:
+        std::unordered_map<std::string_view, rtti_entry> entries{}; // The names point into the module
+    };
+
+    struct msvc_rtti_entry {
+        const std::byte* type_descriptor{};         // The TypeDescriptor of the class
+        const std::byte* complete_object_locator{}; // The RTTICompleteObjectLocator of the primary vtable, or nullptr
+        const std::byte* vtable{};                  // The primary vtable, or nullptr
+    };
+
+    /// An index of the MSVC type information of a 64-bit PE image, keyed by decorated type name, i.e. ".?AVFoo@@" for a
+    /// class or ".?AUFoo@@" for a struct. Type descriptors are found by name, complete object locators by the image
+    /// relative address of themselves and their type descriptor, and vtables are preceded by the absolute address of
+    /// their locator, for which the non-executable sections are swept once. Empty for 32-bit images.
+    class msvc_rtti_index {
+    public:
+        explicit msvc_rtti_index(const pe_image& image);
+
+        /// Returns the type information of a class by its decorated name, or std::nullopt if there is none
+        [[nodiscard]] std::optional<msvc_rtti_entry> find(std::string_view decoratedName) const;
+
+        /// Returns the vtable of a class by its decorated name, or nullptr if there is none
+        [[nodiscard]] const_scan_result find_vtable(std::string_view decoratedName) const;
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return this->entries.size();
+        }
+
+    private:
+        [[maybe_unused]] pe_image image; // Keeps the file mapped
+        std::unordered_map<std::string_view, msvc_rtti_entry> entries{}; // The names point into the image
+    };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <filesystem>
+    #include <memory>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "batch.hpp"
+#include "export.hpp"
+#include "process.hpp"
+#include "scanner.hpp"
+
+LIBHAT_EXPORT namespace hat::detail {
+    struct scan_cache_impl;
+}
+
+LIBHAT_EXPORT namespace hat {
+
+    /// A file of the offsets that signatures were found at in a specific build of a module. The file is memory mapped,
+    /// and its entries are discarded if it was made for a different build. When a signature has an entry, only its
+    /// bytes at the cached offset are compared instead of scanning the section, and a scan is done if they don't match.
+    /// Only signatures that were found are cached.
+    class scan_cache {
+    public:
+        explicit scan_cache(std::filesystem::path path, process::module mod = process::get_process_module());
+        ~scan_cache();
+
+        scan_cache(const scan_cache&) = delete;
+        scan_cache& operator=(const scan_cache&) = delete;
+        scan_cache(scan_cache&&) noexcept;
+        scan_cache& operator=(scan_cache&&) noexcept;
+
+        /// Same as the find_pattern overload for a section of a module, using the cached offset if there is one
+        [[nodiscard]] scan_result find_pattern(
+            signature_view   signature,
+            std::string_view section,
+            scan_alignment   alignment = scan_alignment::X1,
+            scan_hint        hints = scan_hint::none
+        );
+
+        /// Same as hat::resolve_all, only the requests without a valid cached offset are scanned for
+        [[nodiscard]] std::vector<scan_result> resolve_all(
+            std::span<const scan_request> requests,
+            const batch_options&          options = {}
+        );
+
+        /// Writes the cache to its file if any entries were added or changed since it was loaded. The file is replaced
+        /// atomically. Returns false if it couldn't be written.
+        bool save();
+
+        /// The number of lookups that were answered from the cache, and the number that needed a scan
+        [[nodiscard]] std::size_t hits() const;
+        [[nodiscard]] std::size_t misses() const;
+
+    private:
+        std::unique_ptr<detail::scan_cache_impl> impl;
+    };
+}
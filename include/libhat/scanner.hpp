@@ -101,6 +101,23 @@ LIBHAT_EXPORT namespace hat {
     using scan_result = scan_result_base<std::byte>;
     using const_scan_result = scan_result_base<const std::byte>;
 
+    /// The result of an approximate signature scan. Alongside the matched address, the number of signature elements
+    /// which did not match the data at that address is provided.
+    template<typename T> requires (sizeof(T) == 1)
+    struct fuzzy_scan_result_base {
+        scan_result_base<T> result{};
+        std::size_t mismatches{};
+
+        [[nodiscard]] constexpr bool has_result() const noexcept {
+            return this->result.has_result();
+        }
+
+        [[nodiscard]] constexpr auto operator<=>(const fuzzy_scan_result_base&) const noexcept = default;
+    };
+
+    using fuzzy_scan_result = fuzzy_scan_result_base<std::byte>;
+    using const_fuzzy_scan_result = fuzzy_scan_result_base<const std::byte>;
+
     enum class scan_alignment : std::uint8_t {
         X1 = 1,
         X4 = 4,
@@ -108,10 +125,11 @@ LIBHAT_EXPORT namespace hat {
     };
 
     enum class scan_hint : std::uint64_t {
-        none    = 0,      // no hints
-        x86_64  = 1 << 0, // The data being scanned is x86_64 machine code
-        pair0   = 1 << 1, // Only utilize byte pair based scanning if the signature starts with a byte pair
-        aarch64 = 1 << 2, // The data being scanned is AArch64 machine code
+        none            = 0,      // no hints
+        x86_64          = 1 << 0, // The data being scanned is x86_64 machine code
+        pair0           = 1 << 1, // Only utilize byte pair based scanning if the signature starts with a byte pair
+        aarch64         = 1 << 2, // The data being scanned is AArch64 machine code
+        adaptive_anchor = 1 << 3, // Switch to a different anchor, at most once per scan, if the current one matches too often
     };
 
     constexpr scan_hint operator|(scan_hint lhs, scan_hint rhs) {
@@ -133,8 +151,97 @@ LIBHAT_EXPORT namespace hat {
         lhs = lhs & rhs;
         return lhs;
     }
+
+    /// The scanner implementations that can be selected by find_pattern
+    enum class scan_mode {
+        Auto,     // Picks a mode at runtime
+        Single,   // std::find + std::equal
+        SSE,      // x86/x64 SSE 4.1
+        AVX2,     // x86/x64 AVX2
+        AVX512,   // x64 AVX512
+        Neon,     // ARMv7+ Neon
+        AVX512VL, // x64 AVX512 on 256-bit vectors, with VBMI byte permutes
+        SWAR,     // Portable, compares 64-bit words
+        Horspool, // Boyer-Moore-Horspool skip table over the longest run of fully masked bytes
+    };
+
+    /// Buffer sizes for which scan_mode::Auto can pick a different scanner
+    enum class scan_size_class : std::uint8_t {
+        small,  // Less than 64 KiB
+        medium, // Less than 4 MiB
+        large,  // 4 MiB or more
+    };
+
+    inline constexpr std::size_t scan_size_class_count = 3;
+
+    [[nodiscard]] constexpr scan_size_class get_scan_size_class(const std::size_t size) noexcept {
+        if (size < (std::size_t{1} << 16)) {
+            return scan_size_class::small;
+        }
+        if (size < (std::size_t{1} << 22)) {
+            return scan_size_class::medium;
+        }
+        return scan_size_class::large;
+    }
+
+    /// Returns whether the scan mode was compiled in and is supported by the host CPU. scan_mode::Auto,
+    /// scan_mode::Single, scan_mode::SWAR and scan_mode::Horspool are always supported.
+    [[nodiscard]] bool is_scan_mode_supported(scan_mode mode) noexcept;
+
+    /// Returns the scan mode picked from the host CPU's features when no preference is set
+    [[nodiscard]] scan_mode get_default_scan_mode() noexcept;
+
+    /// Makes scan_mode::Auto use the specified mode for buffers of the size class. Passing scan_mode::Auto restores
+    /// the default selection. Signatures with a run of known bytes long enough for scan_mode::Horspool to outpace the
+    /// specified mode still use it. Returns false without changing anything if the mode isn't supported. Only affects
+    /// scan contexts created afterward.
+    bool set_preferred_scan_mode(scan_size_class sizeClass, scan_mode mode) noexcept;
+
+    /// Makes scan_mode::Auto use the specified mode for all buffer sizes
+    bool set_preferred_scan_mode(scan_mode mode) noexcept;
+
+    /// Returns the preference for the size class, scan_mode::Auto if there is none
+    [[nodiscard]] scan_mode get_preferred_scan_mode(scan_size_class sizeClass) noexcept;
+
+#ifdef LIBHAT_SCAN_STATS
+    /// Statistics collected during a single find_pattern call. Only available if libhat is built with the
+    /// LIBHAT_SCAN_STATS option.
+    struct scan_stats {
+        std::string_view kernel{};                 // The scanner that processed the range, e.g. "AVX2"
+        std::size_t anchor_index{};                // The index of the signature byte that was searched for
+        std::optional<std::size_t> pair_index{};   // The index of the byte pair that was searched for, if any
+        bool reanchored{};                         // Whether the scanner switched anchors during the scan
+        std::size_t vectors{};                     // The number of vectors compared against the anchor
+        std::size_t candidates{};                  // The number of positions where the full signature was checked
+        std::size_t scalar_bytes{};                // The number of bytes scanned without vectorization
+        std::uint64_t cycles{};                    // Elapsed timestamp counter ticks on x86, nanoseconds elsewhere
+        bool found{};
+
+        /// The fraction of candidates that didn't match the full signature
+        [[nodiscard]] constexpr double false_positive_rate() const noexcept {
+            if (this->candidates == 0) {
+                return 0.0;
+            }
+            const auto misses = this->candidates - (this->found ? 1 : 0);
+            return static_cast<double>(misses) / static_cast<double>(this->candidates);
+        }
+    };
+#endif
 }
 
+#ifdef LIBHAT_SCAN_STATS
+    /// Runs the statements with "stats" bound to the scan_stats of the context, if it has any
+    #define LIBHAT_RECORD_STATS(context, ...) \
+        do { \
+            if (auto* const statsPtr = (context).stats) LIBHAT_UNLIKELY { \
+                [[maybe_unused]] auto& stats = *statsPtr; \
+                __VA_ARGS__; \
+            } \
+        } while (0)
+#else
+    #define LIBHAT_RECORD_STATS(context, ...) do {} while (0)
+#endif
+
 namespace hat::detail {
 
     class scan_context;
@@ -145,23 +252,22 @@ namespace hat::detail {
         std::size_t vectorSize{};
     };
 
-    enum class scan_mode {
-        Auto,   // Picks a mode at runtime
-        Single, // std::find + std::equal
-        SSE,    // x86/x64 SSE 4.1
-        AVX2,   // x86/x64 AVX2
-        AVX512, // x64 AVX512
-        Neon,   // ARMv7+ Neon
-    };
+    using hat::scan_mode;
 
     class scan_context {
     public:
         signature_view signature{};
+        packed_signature packed{};
         scan_function_t scanner{};
         scan_alignment alignment{};
         scan_hint hints{};
         std::size_t cmpIndex{};
         std::optional<std::size_t> pairIndex{};
+        bool adaptive{};
+        std::array<scan_function_t, scan_size_class_count> sizeClassScanners{};
+#ifdef LIBHAT_SCAN_STATS
+        scan_stats* stats{};
+#endif
 
         [[nodiscard]] constexpr const_scan_result scan(const std::byte* begin, const std::byte* end) const {
             if (signature.size() > static_cast<std::size_t>(std::distance(begin, end))) LIBHAT_UNLIKELY {
@@ -172,6 +278,10 @@ namespace hat::detail {
 
         void apply_hints(const scanner_context&);
 
+        /// Returns a copy of this context anchored on the bytes which are least frequent in the sample. Used by the
+        /// vectorized scanners when the current anchor matches in too many positions. The copy won't adapt again.
+        [[nodiscard]] scan_context reanchored(std::span<const std::byte> sample) const;
+
         template<scan_mode mode = scan_mode::Auto>
         static constexpr scan_context create(signature_view signature, scan_alignment alignment, scan_hint hints);
 
@@ -205,6 +315,11 @@ namespace hat::detail {
     template<scan_mode>
     scan_function_t resolve_scanner(scan_context&);
 
+#ifdef LIBHAT_SCAN_STATS
+    /// Reads the timestamp counter on x86, or a nanosecond clock on other architectures
+    std::uint64_t read_cycle_counter() noexcept;
+#endif
+
     template<>
     scan_function_t resolve_scanner<scan_mode::Auto>(scan_context&);
 
@@ -212,7 +327,14 @@ namespace hat::detail {
     const_scan_result find_pattern_single(const std::byte* begin, const std::byte* end, const scan_context& context) {
         static constexpr auto stride = alignment_stride<alignment>;
         const auto signature = context.signature;
-        const auto cmpByte = *signature[context.cmpIndex];
+        const auto anchor = signature[context.cmpIndex];
+
+        LIBHAT_RECORD_STATS(context,
+            if (stats.kernel.empty()) {
+                stats.kernel = "Single";
+                stats.anchor_index = context.cmpIndex;
+            }
+            stats.scalar_bytes += static_cast<std::size_t>(end - begin));
 
         const auto scanBegin = align_up<stride>(begin) + context.cmpIndex;
         const auto scanEnd = align_up<stride>(end - signature.size() + 1) + context.cmpIndex;
@@ -222,8 +344,9 @@ namespace hat::detail {
         }
 
         for (auto i = scanBegin; i != scanEnd; i += stride) {
-            if (*i == cmpByte) {
+            if (anchor == *i) {
                 const auto start = i - context.cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
                 const auto match = std::equal(signature.begin(), signature.end(), start);
                 if (match) LIBHAT_UNLIKELY {
                     return start;
@@ -237,9 +360,32 @@ namespace hat::detail {
     template<>
     constexpr const_scan_result find_pattern_single<scan_alignment::X1>(const std::byte* begin, const std::byte* end, const scan_context& context) {
         const auto signature = context.signature;
-        const auto firstByte = *signature[context.cmpIndex];
+        const auto anchor = signature[context.cmpIndex];
+        const auto firstByte = *anchor;
         const auto scanEnd = end - signature.size() + 1 + context.cmpIndex;
 
+        LIBHAT_RECORD_STATS(context,
+            if (stats.kernel.empty()) {
+                stats.kernel = "Single";
+                stats.anchor_index = context.cmpIndex;
+            }
+            stats.scalar_bytes += static_cast<std::size_t>(end - begin));
+
+        if (!anchor.all()) LIBHAT_UNLIKELY {
+            // Partially masked anchors can't be searched for with memchr
+            for (auto i = begin + context.cmpIndex; i != scanEnd; i++) {
+                if (anchor == *i) {
+                    const auto start = i - context.cmpIndex;
+                    LIBHAT_RECORD_STATS(context, stats.candidates++);
+                    const auto match = std::equal(signature.begin(), signature.end(), start);
+                    if (match) LIBHAT_UNLIKELY {
+                        return start;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
         for (auto i = begin + context.cmpIndex; i != scanEnd; i++) {
             // Use std::find to efficiently find the first byte
             if LIBHAT_IF_CONSTEVAL {
@@ -259,6 +405,7 @@ namespace hat::detail {
                 #endif
             }
             const auto start = i - context.cmpIndex;
+            LIBHAT_RECORD_STATS(context, stats.candidates++);
             const auto match = std::equal(signature.begin(), signature.end(), start);
             if (match) LIBHAT_UNLIKELY {
                 return start;
@@ -277,10 +424,249 @@ namespace hat::detail {
         LIBHAT_UNREACHABLE();
     }
 
+    struct signature_run {
+        std::size_t offset{};
+        std::size_t size{};
+    };
+
+    /// Finds the longest run of fully masked elements in the signature, preferring the last one on ties
+    [[nodiscard]] constexpr signature_run find_longest_exact_run(const signature_view signature) {
+        signature_run longest{};
+        std::size_t start{};
+        for (std::size_t i = 0; i <= signature.size(); i++) {
+            if (i == signature.size() || !signature[i].all()) {
+                if (i - start >= longest.size && i != start) {
+                    longest = {start, i - start};
+                }
+                start = i + 1;
+            }
+        }
+        return longest;
+    }
+
+    /// The longest window searched by the Horspool scanner, which keeps the shift table entries in a single byte
+    inline constexpr std::size_t horspool_max_window = 255;
+
+    /// The shortest run of fully masked bytes for which the Horspool scanner is used for scans that are evaluated at
+    /// compile time, where the alternative is scan_mode::Single
+    inline constexpr std::size_t horspool_min_window_consteval = 4;
+
+    template<scan_alignment alignment>
+    constexpr const_scan_result find_pattern_horspool(const std::byte* begin, const std::byte* end, const scan_context& context) {
+        const auto signature = context.signature;
+        auto [runOffset, runSize] = find_longest_exact_run(signature);
+        if (runSize > horspool_max_window) {
+            runOffset += runSize - horspool_max_window;
+            runSize = horspool_max_window;
+        }
+
+        // Without a run to skip over, this is just slower than the anchor search
+        if (runSize < 2) {
+            return find_pattern_single<alignment>(begin, end, context);
+        }
+
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "Horspool";
+            stats.anchor_index = runOffset + runSize - 1;
+            stats.scalar_bytes += static_cast<std::size_t>(end - begin));
+
+        if (static_cast<std::size_t>(end - begin) < signature.size()) {
+            return nullptr;
+        }
+
+        // The distance from the last occurrence of each byte in the run (excluding its last element) to its end
+        const auto run = signature.subspan(runOffset, runSize);
+        std::array<std::uint8_t, 256> shifts{};
+        shifts.fill(static_cast<std::uint8_t>(runSize));
+        for (std::size_t i = 0; i + 1 < runSize; i++) {
+            shifts[std::to_integer<std::uint8_t>(run[i].value())] = static_cast<std::uint8_t>(runSize - 1 - i);
+        }
+        const auto lastByte = run.back().value();
+
+        // Positions are tracked as offsets, since a shift may step past the end of the range
+        const auto last = static_cast<std::size_t>(end - begin) - signature.size() + runOffset;
+        for (std::size_t pos = runOffset; pos <= last;) {
+            const auto window = begin + pos;
+            const auto tail = window[runSize - 1];
+            if (tail == lastByte && std::equal(run.begin(), std::prev(run.end()), window)) {
+                const auto start = window - runOffset;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
+                bool aligned = true;
+                if constexpr (alignment != scan_alignment::X1) {
+                    aligned = reinterpret_cast<std::uintptr_t>(start) % alignment_stride<alignment> == 0;
+                }
+                if (aligned && std::equal(signature.begin(), signature.end(), start)) LIBHAT_UNLIKELY {
+                    return start;
+                }
+            }
+            pos += shifts[std::to_integer<std::uint8_t>(tail)];
+        }
+        return nullptr;
+    }
+
+    template<>
+    constexpr scan_function_t resolve_scanner<scan_mode::Horspool>(scan_context& context) {
+        switch (context.alignment) {
+            case scan_alignment::X1: return &find_pattern_horspool<scan_alignment::X1>;
+            case scan_alignment::X4: return &find_pattern_horspool<scan_alignment::X4>;
+            case scan_alignment::X16: return &find_pattern_horspool<scan_alignment::X16>;
+        }
+        LIBHAT_UNREACHABLE();
+    }
+
     template<byte_input_iterator T>
     using result_type_for = std::conditional_t<std::is_const_v<std::remove_reference_t<std::iter_reference_t<T>>>,
         const_scan_result, scan_result>;
 
+    template<byte_input_iterator T>
+    using fuzzy_result_type_for = std::conditional_t<std::is_const_v<std::remove_reference_t<std::iter_reference_t<T>>>,
+        const_fuzzy_scan_result, fuzzy_scan_result>;
+
+    /// Counts the number of signature elements which don't match the data, stopping early once "limit" is exceeded.
+    /// Uses the best available vectorized implementation at runtime.
+    std::size_t count_mismatches(const std::byte* data, signature_view signature, std::size_t limit);
+
+    [[nodiscard]] constexpr std::size_t count_mismatches_single(const std::byte* data, const signature_view signature, const std::size_t limit) {
+        std::size_t mismatches{};
+        for (std::size_t i = 0; i < signature.size(); i++) {
+            if (!(signature[i] == data[i])) {
+                if (++mismatches > limit) {
+                    break;
+                }
+            }
+        }
+        return mismatches;
+    }
+
+    /// Returns a score for how unlikely a signature is to match at a random position, used to pick the component of
+    /// a composite signature to anchor the search on.
+    [[nodiscard]] constexpr std::size_t selectivity(const signature_view signature) {
+        std::size_t score{};
+        bool hasAnchor = false;
+        for (const auto& element : signature) {
+            score += static_cast<std::size_t>(std::popcount(std::to_integer<std::uint8_t>(element.mask())));
+            hasAnchor |= element.all();
+        }
+        return hasAnchor ? score : 0;
+    }
+
+    class composite_matcher {
+    public:
+        constexpr composite_matcher(const std::byte* begin, const std::byte* end, const std::span<const composite_component> components, const scan_alignment alignment)
+            : begin(begin), end(end), components(components), stride(to_stride(alignment)) {}
+
+        /// Given the start of component "index", returns the lowest start of the first component for which every other
+        /// component can be placed within its window. Each component's reachable starts are tracked as a set, so a
+        /// position is verified at most once per component, rather than once per path leading to it.
+        [[nodiscard]] constexpr const std::byte* match(const std::size_t index, const std::byte* position) const {
+            const auto offset = position - this->begin;
+            reachable_set forward{offset, {true}};
+            for (auto next = index + 1; next < this->components.size() && !forward.reachable.empty(); next++) {
+                const auto& component = this->components[next];
+                forward = this->step(forward, next, component.min_offset, component.max_offset);
+            }
+            if (forward.reachable.empty()) {
+                return nullptr;
+            }
+
+            reachable_set backward{offset, {true}};
+            for (auto previous = index; previous > 0 && !backward.reachable.empty(); previous--) {
+                const auto& component = this->components[previous];
+                backward = this->step(backward, previous - 1, -component.max_offset, -component.min_offset);
+            }
+            for (std::size_t i = 0; i < backward.reachable.size(); i++) {
+                if (!backward.reachable[i]) {
+                    continue;
+                }
+                const auto candidate = this->begin + backward.first + static_cast<std::ptrdiff_t>(i);
+                if LIBHAT_IF_CONSTEVAL {
+                    return candidate;
+                } else if (reinterpret_cast<std::uintptr_t>(candidate) % this->stride == 0) {
+                    return candidate;
+                }
+            }
+            return nullptr;
+        }
+
+    private:
+        /// The offsets from begin at which a component can start, as a bitmap starting at "first"
+        struct reachable_set {
+            std::ptrdiff_t first{};
+            std::vector<bool> reachable{};
+        };
+
+        [[nodiscard]] constexpr bool verify(const std::size_t index, const std::byte* position) const {
+            const auto& elements = this->components[index].elements;
+            if (static_cast<std::size_t>(this->end - position) < elements.size()) {
+                return false;
+            }
+            return std::equal(elements.begin(), elements.end(), position);
+        }
+
+        /// Returns the starts of component "index" which match, and are within [from + lo, from + hi] of a start in
+        /// "from". The set is empty if there are none.
+        [[nodiscard]] constexpr reachable_set step(const reachable_set& from, const std::size_t index, const std::ptrdiff_t lo, const std::ptrdiff_t hi) const {
+            // Running count of the starts in "from", to check each target's window in constant time
+            std::vector<std::size_t> counts(from.reachable.size() + 1);
+            for (std::size_t i = 0; i < from.reachable.size(); i++) {
+                counts[i + 1] = counts[i] + (from.reachable[i] ? 1 : 0);
+            }
+
+            const auto last = from.first + static_cast<std::ptrdiff_t>(from.reachable.size()) - 1;
+            const auto first = std::max<std::ptrdiff_t>(from.first + lo, 0);
+            const auto limit = std::min<std::ptrdiff_t>(last + hi, this->end - this->begin);
+            reachable_set result{first, {}};
+            if (first > limit) {
+                return result;
+            }
+
+            result.reachable.resize(static_cast<std::size_t>(limit - first + 1));
+            bool any = false;
+            for (auto target = first; target <= limit; target++) {
+                const auto sourceLo = std::max(target - hi, from.first);
+                const auto sourceHi = std::min(target - lo, last);
+                if (sourceLo > sourceHi) {
+                    continue;
+                }
+                const auto sources = counts[static_cast<std::size_t>(sourceHi - from.first + 1)] - counts[static_cast<std::size_t>(sourceLo - from.first)];
+                if (sources != 0 && this->verify(index, this->begin + target)) {
+                    result.reachable[static_cast<std::size_t>(target - first)] = true;
+                    any = true;
+                }
+            }
+            if (!any) {
+                result.reachable.clear();
+            }
+            return result;
+        }
+
+        const std::byte* begin;
+        const std::byte* end;
+        std::span<const composite_component> components;
+        std::size_t stride;
+    };
+
+    /// Splits a signature into "parts" contiguous sub-signatures, each containing at least one fully masked element.
+    /// By the pigeonhole principle, any match with fewer than "parts" mismatches must match one of the sub-signatures
+    /// exactly. Returns the starting offset of each sub-signature, or nothing if such a partition isn't possible.
+    [[nodiscard]] constexpr std::optional<std::vector<std::size_t>> partition_signature(const signature_view signature, const std::size_t parts) {
+        std::vector<std::size_t> anchors{};
+        for (std::size_t i = 0; i < signature.size(); i++) {
+            if (signature[i].all()) {
+                anchors.push_back(i);
+            }
+        }
+        if (parts == 0 || anchors.size() < parts) {
+            return std::nullopt;
+        }
+
+        std::vector<std::size_t> offsets(parts);
+        for (std::size_t p = 1; p < parts; p++) {
+            offsets[p] = anchors[p * anchors.size() / parts];
+        }
+        return offsets;
+    }
+
     template<scan_mode mode>
     constexpr scan_context scan_context::create(const signature_view signature, const scan_alignment alignment, const scan_hint hints) {
         std::size_t cmpIndex{};
@@ -291,12 +677,34 @@ namespace hat::detail {
             cmpIndex++;
         }
 
+        // Without a fully masked byte, anchor on the most selective masked byte instead
+        const bool exactAnchor = cmpIndex < signature.size();
+        if (!exactAnchor) {
+            cmpIndex = 0;
+            int bestScore = -1;
+            for (std::size_t i = 0; i < signature.size(); i++) {
+                const auto score = std::popcount(std::to_integer<std::uint8_t>(signature[i].mask()));
+                if (signature[i].any() && score > bestScore) {
+                    bestScore = score;
+                    cmpIndex = i;
+                }
+            }
+        }
+
         scan_context ctx{};
         ctx.signature = signature;
+        ctx.packed = packed_signature{signature};
         ctx.alignment = alignment;
         ctx.hints = hints;
         ctx.cmpIndex = cmpIndex;
+        ctx.adaptive = static_cast<bool>(hints & scan_hint::adaptive_anchor) && !static_cast<bool>(hints & scan_hint::pair0)
+            && std::ranges::count_if(signature, &signature_element::all) > 1;
         if LIBHAT_IF_CONSTEVAL {
+            ctx.scanner = find_longest_exact_run(signature).size >= horspool_min_window_consteval
+                ? resolve_scanner<scan_mode::Horspool>(ctx)
+                : resolve_scanner<scan_mode::Single>(ctx);
+        } else if (!exactAnchor && !signature.empty()) {
+            // The vectorized scanners compare the anchor byte exactly
             ctx.scanner = resolve_scanner<scan_mode::Single>(ctx);
         } else {
             ctx.scanner = resolve_scanner<mode>(ctx);
@@ -337,6 +745,46 @@ LIBHAT_EXPORT namespace hat {
         return find_pattern(std::ranges::begin(range), std::ranges::end(range), signature, alignment, hints);
     }
 
+#ifdef LIBHAT_SCAN_STATS
+    /// Implementation of find_pattern which also records statistics about the scan into "stats"
+    template<detail::byte_input_iterator Iter>
+    [[nodiscard]] auto find_pattern(
+        const Iter            beginIt,
+        const Iter            endIt,
+        const signature_view  signature,
+        scan_stats&           stats,
+        const scan_alignment  alignment = scan_alignment::X1,
+        const scan_hint       hints = scan_hint::none
+    ) noexcept -> detail::result_type_for<Iter> {
+        auto context = detail::scan_context::create(signature, alignment, hints);
+        const auto begin = std::to_address(beginIt);
+        const auto end = std::to_address(endIt);
+
+        stats = {};
+        context.stats = &stats;
+        const auto start = detail::read_cycle_counter();
+        const auto result = context.scan(begin, end);
+        stats.cycles = detail::read_cycle_counter() - start;
+        stats.found = result.has_result();
+
+        return result.has_result()
+            ? const_cast<typename detail::result_type_for<Iter>::underlying_type>(result.get())
+            : nullptr;
+    }
+
+    /// Range overload of find_pattern which also records statistics about the scan into "stats"
+    template<detail::byte_input_range Range>
+    [[nodiscard]] auto find_pattern(
+        Range&& range,
+        const signature_view  signature,
+        scan_stats&           stats,
+        const scan_alignment  alignment = scan_alignment::X1,
+        const scan_hint       hints = scan_hint::none
+    ) noexcept -> detail::result_type_for<std::ranges::iterator_t<Range>> {
+        return find_pattern(std::ranges::begin(range), std::ranges::end(range), signature, stats, alignment, hints);
+    }
+#endif
+
     /// Perform a signature scan on a specific section of the process module or a specified module
     [[nodiscard]] inline scan_result find_pattern(
         const signature_view   signature,
@@ -349,6 +797,132 @@ LIBHAT_EXPORT namespace hat {
         return find_pattern(data.begin(), data.end(), signature, alignment, hints);
     }
 
+    /// Root implementation of find_pattern for signatures with byte classes. The elements are searched for with the
+    /// regular scanner, and each of their matches is then checked against the classes in scalar code before the scan
+    /// resumes after it.
+    template<detail::byte_input_iterator Iter>
+    [[nodiscard]] constexpr auto find_pattern(
+        const Iter             beginIt,
+        const Iter             endIt,
+        const class_signature& signature,
+        const scan_alignment   alignment = scan_alignment::X1,
+        const scan_hint        hints = scan_hint::none
+    ) noexcept -> detail::result_type_for<Iter> {
+        const auto context = detail::scan_context::create(signature.elements, alignment, hints);
+        const auto begin = std::to_address(beginIt);
+        const auto end = std::to_address(endIt);
+
+        for (const std::byte* i = begin; i < end;) {
+            const auto result = context.scan(i, end);
+            if (!result.has_result()) {
+                break;
+            }
+            if (signature.verify_classes(result.get())) {
+                return const_cast<typename detail::result_type_for<Iter>::underlying_type>(result.get());
+            }
+            i = result.get() + 1;
+        }
+        return nullptr;
+    }
+
+    /// Range overload of find_pattern for signatures with byte classes
+    template<detail::byte_input_range Range>
+    [[nodiscard]] constexpr auto find_pattern(
+        Range&&                range,
+        const class_signature& signature,
+        const scan_alignment   alignment = scan_alignment::X1,
+        const scan_hint        hints = scan_hint::none
+    ) noexcept -> detail::result_type_for<std::ranges::iterator_t<Range>> {
+        return find_pattern(std::ranges::begin(range), std::ranges::end(range), signature, alignment, hints);
+    }
+
+    /// Perform a signature scan with byte classes on a specific section of the process module or a specified module
+    [[nodiscard]] inline scan_result find_pattern(
+        const class_signature& signature,
+        const std::string_view section,
+        const process::module& mod = process::get_process_module(),
+        const scan_alignment   alignment = scan_alignment::X1,
+        const scan_hint        hints = scan_hint::none
+    ) noexcept {
+        const auto data = mod.get_section_data(section);
+        return find_pattern(data.begin(), data.end(), signature, alignment, hints);
+    }
+
+    /// Root implementation of find_pattern for composite signatures. The returned result points to the start of the
+    /// first component, for the match whose first component starts at the lowest address. The component with the
+    /// highest selectivity is searched for with the vectorized scanner, and the remaining components are only verified
+    /// within their windows around each of its matches.
+    template<detail::byte_input_iterator Iter>
+    [[nodiscard]] constexpr auto find_pattern(
+        const Iter                 beginIt,
+        const Iter                 endIt,
+        const composite_signature& signature,
+        const scan_alignment       alignment = scan_alignment::X1,
+        const scan_hint            hints = scan_hint::none
+    ) noexcept -> detail::result_type_for<Iter> {
+        using pointer_t = typename detail::result_type_for<Iter>::underlying_type;
+
+        const auto components = signature.components();
+        if (components.empty()) {
+            return nullptr;
+        }
+
+        std::size_t anchor{};
+        for (std::size_t i = 1; i < components.size(); i++) {
+            if (detail::selectivity(components[i].elements) > detail::selectivity(components[anchor].elements)) {
+                anchor = i;
+            }
+        }
+
+        // The first component starts at most this far before the anchor, so once a match is found, only the anchor
+        // matches within this distance after it can lead to a lower one
+        std::ptrdiff_t reach{};
+        for (std::size_t i = 1; i <= anchor; i++) {
+            reach += components[i].max_offset;
+        }
+
+        const auto begin = std::to_address(beginIt);
+        const auto end = std::to_address(endIt);
+        const auto context = detail::scan_context::create(components[anchor].elements, scan_alignment::X1, hints);
+        const detail::composite_matcher matcher{begin, end, components, alignment};
+
+        const std::byte* best{};
+        for (const std::byte* i = begin; i < end;) {
+            const auto result = context.scan(i, end);
+            if (!result.has_result() || (best && result.get() - best > reach)) {
+                break;
+            }
+            if (const auto match = matcher.match(anchor, result.get()); match && (!best || match < best)) {
+                best = match;
+            }
+            i = result.get() + 1;
+        }
+        return const_cast<pointer_t>(best);
+    }
+
+    /// Range overload of find_pattern for composite signatures
+    template<detail::byte_input_range Range>
+    [[nodiscard]] constexpr auto find_pattern(
+        Range&&                    range,
+        const composite_signature& signature,
+        const scan_alignment       alignment = scan_alignment::X1,
+        const scan_hint            hints = scan_hint::none
+    ) noexcept -> detail::result_type_for<std::ranges::iterator_t<Range>> {
+        return find_pattern(std::ranges::begin(range), std::ranges::end(range), signature, alignment, hints);
+    }
+
+    /// Perform a composite signature scan on a specific section of the process module or a specified module
+    [[nodiscard]] inline scan_result find_pattern(
+        const composite_signature& signature,
+        const std::string_view     section,
+        const process::module&     mod = process::get_process_module(),
+        const scan_alignment       alignment = scan_alignment::X1,
+        const scan_hint            hints = scan_hint::none
+    ) noexcept {
+        const auto data = mod.get_section_data(section);
+        return find_pattern(data.begin(), data.end(), signature, alignment, hints);
+    }
+
     /// Finds all of the matches for the given signature in the input range, and writes the results into the output
     /// range. If there is no space in the output range, the function will exit early. The first element of the returned
     /// pair is an end iterator into the input range at the point in which the pattern search stopped. The second
@@ -467,6 +1041,124 @@ LIBHAT_EXPORT namespace hat {
     ) noexcept -> std::vector<detail::result_type_for<std::ranges::iterator_t<In>>> {
         return find_all_pattern(std::ranges::begin(rangeIn), std::ranges::end(rangeIn), signature, alignment, hints);
     }
+
+    /// Root implementation of find_pattern_fuzzy. Finds the match for the signature in the input range that contains
+    /// the fewest mismatched elements, tolerating at most "maxMismatches". If multiple matches share the lowest number
+    /// of mismatches, the first is returned. The signature is partitioned into maxMismatches + 1 sub-signatures which
+    /// are each searched for exactly, and only the positions they match are verified against the full signature.
+    template<detail::byte_input_iterator Iter>
+    [[nodiscard]] constexpr auto find_pattern_fuzzy(
+        const Iter            beginIt,
+        const Iter            endIt,
+        const signature_view  signature,
+        const std::size_t     maxMismatches,
+        const scan_alignment  alignment = scan_alignment::X1,
+        const scan_hint       hints = scan_hint::none
+    ) noexcept -> detail::fuzzy_result_type_for<Iter> {
+        using result_t = detail::fuzzy_result_type_for<Iter>;
+        using pointer_t = typename decltype(std::declval<result_t>().result)::underlying_type;
+
+        const auto begin = std::to_address(beginIt);
+        const auto end = std::to_address(endIt);
+        const auto size = signature.size();
+        if (size == 0 || size > static_cast<std::size_t>(end - begin)) {
+            return {};
+        }
+
+        const auto stride = detail::to_stride(alignment);
+        const auto aligned = [=](const std::byte* ptr) {
+            if LIBHAT_IF_CONSTEVAL {
+                return true;
+            } else {
+                return reinterpret_cast<std::uintptr_t>(ptr) % stride == 0;
+            }
+        };
+        const auto count = [&](const std::byte* ptr, const std::size_t limit) {
+            if LIBHAT_IF_CONSTEVAL {
+                return detail::count_mismatches_single(ptr, signature, limit);
+            } else {
+                return detail::count_mismatches(ptr, signature, limit);
+            }
+        };
+
+        const std::byte* best{};
+        std::size_t bestMismatches = maxMismatches;
+        const auto offer = [&](const std::byte* start) {
+            if (!aligned(start)) {
+                return;
+            }
+            const auto mismatches = count(start, bestMismatches);
+            if (mismatches > bestMismatches || (mismatches == bestMismatches && best && best < start)) {
+                return;
+            }
+            best = start;
+            bestMismatches = mismatches;
+        };
+
+        const auto offsets = detail::partition_signature(signature, maxMismatches + 1);
+        if (!offsets) {
+            // Too few fully masked elements to anchor on, every position has to be checked
+            for (auto i = begin; i != end - size + 1; i++) {
+                offer(i);
+                if (best && bestMismatches == 0) {
+                    break;
+                }
+            }
+        } else {
+            for (std::size_t p = 0; p < offsets->size(); p++) {
+                const auto offset = (*offsets)[p];
+                const auto length = (p + 1 == offsets->size() ? size : (*offsets)[p + 1]) - offset;
+                const auto part = signature.subspan(offset, length);
+                const auto context = detail::scan_context::create(part, scan_alignment::X1, hints);
+
+                const auto partEnd = end - (size - offset - length);
+                for (const std::byte* i = begin + offset; i < partEnd;) {
+                    const auto result = context.scan(i, partEnd);
+                    if (!result.has_result()) {
+                        break;
+                    }
+                    offer(result.get() - offset);
+                    i = result.get() + 1;
+                }
+
+                // Any exact match is also an exact match for the first part, which is scanned in order, so the first
+                // exact match found there is the earliest one. If the first part has none, none exist.
+                if (best && bestMismatches == 0) {
+                    break;
+                }
+            }
+        }
+
+        if (!best) {
+            return {};
+        }
+        return {const_cast<pointer_t>(best), bestMismatches};
+    }
+
+    /// Range overload of find_pattern_fuzzy
+    template<detail::byte_input_range Range>
+    [[nodiscard]] constexpr auto find_pattern_fuzzy(
+        Range&&               range,
+        const signature_view  signature,
+        const std::size_t     maxMismatches,
+        const scan_alignment  alignment = scan_alignment::X1,
+        const scan_hint       hints = scan_hint::none
+    ) noexcept -> detail::fuzzy_result_type_for<std::ranges::iterator_t<Range>> {
+        return find_pattern_fuzzy(std::ranges::begin(range), std::ranges::end(range), signature, maxMismatches, alignment, hints);
+    }
+
+    /// Perform an approximate signature scan on a specific section of the process module or a specified module
+    [[nodiscard]] inline fuzzy_scan_result find_pattern_fuzzy(
+        const signature_view   signature,
+        const std::size_t      maxMismatches,
+        const std::string_view section,
+        const process::module& mod = process::get_process_module(),
+        const scan_alignment   alignment = scan_alignment::X1,
+        const scan_hint        hints = scan_hint::none
+    ) noexcept {
+        const auto data = mod.get_section_data(section);
+        return find_pattern_fuzzy(data.begin(), data.end(), signature, maxMismatches, alignment, hints);
+    }
 }
 
 LIBHAT_EXPORT namespace hat::experimental {
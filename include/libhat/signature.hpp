@@ -6,6 +6,7 @@
     #include <bit>
     #include <optional>
     #include <ranges>
+    #include <span>
     #include <string_view>
     #include <vector>
 #endif
@@ -88,6 +89,180 @@ LIBHAT_EXPORT namespace hat {
     template<std::size_t N>
     using fixed_signature = std::array<signature_element, N>;
 
+    /// A signature which stores up to N elements inline, and only allocates if it grows beyond that. Like the other
+    /// signature types, it converts to a signature_view.
+    template<std::size_t N = 64> requires (N > 0)
+    class small_signature {
+    public:
+        using value_type     = signature_element;
+        using size_type      = std::size_t;
+        using iterator       = signature_element*;
+        using const_iterator = const signature_element*;
+
+        constexpr small_signature() noexcept = default;
+
+        template<std::input_iterator Iter, std::sentinel_for<Iter> Sent>
+        constexpr small_signature(Iter first, const Sent last) {
+            for (; first != last; ++first) {
+                this->emplace_back(*first);
+            }
+        }
+
+        constexpr explicit small_signature(const signature_view elements)
+            : small_signature(elements.begin(), elements.end()) {}
+
+        template<typename... Args>
+        constexpr signature_element& emplace_back(Args&&... args) {
+            if (!this->spilled() && this->inlineSize < N) {
+                this->inlineElements[this->inlineSize] = signature_element{std::forward<Args>(args)...};
+                return this->inlineElements[this->inlineSize++];
+            }
+            this->spill(N * 2);
+            return this->heap.emplace_back(std::forward<Args>(args)...);
+        }
+
+        constexpr void push_back(const signature_element& element) {
+            this->emplace_back(element);
+        }
+
+        constexpr void reserve(const std::size_t capacity) {
+            if (this->spilled()) {
+                this->heap.reserve(capacity);
+            } else if (capacity > N) {
+                this->spill(capacity);
+            }
+        }
+
+        constexpr void resize(const std::size_t size) {
+            if (!this->spilled() && size <= N) {
+                std::fill(this->inlineElements.begin() + static_cast<std::ptrdiff_t>(std::min(size, this->inlineSize)),
+                    this->inlineElements.begin() + static_cast<std::ptrdiff_t>(size), signature_element{});
+                this->inlineSize = size;
+            } else {
+                this->spill(size);
+                this->heap.resize(size);
+            }
+        }
+
+        constexpr void clear() noexcept {
+            this->inlineSize = 0;
+            this->heap.clear();
+        }
+
+        /// Whether the elements are stored inline, rather than on the heap
+        [[nodiscard]] constexpr bool is_inline() const noexcept {
+            return !this->spilled();
+        }
+
+        [[nodiscard]] constexpr signature_element* data() noexcept {
+            return this->spilled() ? this->heap.data() : this->inlineElements.data();
+        }
+
+        [[nodiscard]] constexpr const signature_element* data() const noexcept {
+            return this->spilled() ? this->heap.data() : this->inlineElements.data();
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept {
+            return this->spilled() ? this->heap.size() : this->inlineSize;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return this->size() == 0;
+        }
+
+        [[nodiscard]] constexpr iterator begin() noexcept { return this->data(); }
+        [[nodiscard]] constexpr iterator end() noexcept { return this->data() + this->size(); }
+        [[nodiscard]] constexpr const_iterator begin() const noexcept { return this->data(); }
+        [[nodiscard]] constexpr const_iterator end() const noexcept { return this->data() + this->size(); }
+
+        [[nodiscard]] constexpr signature_element& operator[](const std::size_t index) noexcept {
+            return this->data()[index];
+        }
+
+        [[nodiscard]] constexpr const signature_element& operator[](const std::size_t index) const noexcept {
+            return this->data()[index];
+        }
+
+    private:
+        // Once spilled, the heap holds every element and keeps its capacity, even when cleared
+        [[nodiscard]] constexpr bool spilled() const noexcept {
+            return this->heap.capacity() != 0;
+        }
+
+        constexpr void spill(const std::size_t capacity) {
+            if (this->spilled()) {
+                return;
+            }
+            this->heap.reserve(std::max(capacity, this->inlineSize + 1));
+            // The explicit bound keeps the compiler from assuming the copy can read past the inline storage
+            const auto inlined = std::span{this->inlineElements}.first(std::min(this->inlineSize, N));
+            this->heap.assign(inlined.begin(), inlined.end());
+            this->inlineSize = 0;
+        }
+
+        std::array<signature_element, N> inlineElements{};
+        std::size_t inlineSize{};
+        std::vector<signature_element> heap{};
+    };
+
+    /// The first 64 elements of a signature with their values and masks in separate arrays, so that a vectorized
+    /// scanner can load them directly. The arrays are padded with elements that match any byte.
+    struct alignas(64) packed_signature {
+        static constexpr std::size_t capacity = 64;
+
+        std::array<std::byte, capacity> values{};
+        std::array<std::byte, capacity> masks{};
+        std::uint64_t known{};  // Bit i is set if element i is fully masked, see signature_element::all
+        std::size_t size{};     // The number of packed elements
+
+        constexpr packed_signature() noexcept = default;
+
+        constexpr explicit packed_signature(const signature_view signature) noexcept {
+            this->size = std::min(signature.size(), capacity);
+            for (std::size_t i = 0; i < this->size; i++) {
+                const auto& element = signature[i];
+                this->values[i] = element.value();
+                this->masks[i] = element.mask();
+                if (element.all()) {
+                    this->known |= std::uint64_t{1} << i;
+                }
+            }
+        }
+    };
+
+    /// A byte class which a single masked value can't represent, such as [41-5A] or [4?|E8], stored as the set of
+    /// bytes it matches.
+    struct signature_class {
+        std::size_t index{}; // The element of the signature that the class belongs to
+        std::array<std::uint64_t, 4> members{};
+
+        constexpr void insert(const std::uint8_t byte) noexcept {
+            this->members[byte >> 6] |= std::uint64_t{1} << (byte & 63);
+        }
+
+        [[nodiscard]] constexpr bool operator==(const std::byte byte) const noexcept {
+            const auto b = std::to_integer<std::uint8_t>(byte);
+            return (this->members[b >> 6] >> (b & 63)) & 1;
+        }
+    };
+
+    /// A signature containing byte classes which a single masked value can't represent. Each class is stored in the
+    /// elements as the smallest masked value enclosing it, which the scanner searches for, and every match is then
+    /// checked against the exact classes with a scalar lookup. The vectorized kernels never see the classes, so a
+    /// class narrows the matches but doesn't speed up the scan. This keeps signature_element at two bytes for all
+    /// other signatures.
+    struct class_signature {
+        signature elements{};
+        std::vector<signature_class> classes{}; // Sorted by index
+
+        /// Whether the classes match the data at the start of a match of the elements
+        [[nodiscard]] constexpr bool verify_classes(const std::byte* data) const noexcept {
+            return std::ranges::all_of(this->classes, [=](const signature_class& cls) {
+                return cls == data[cls.index];
+            });
+        }
+    };
+
     enum class signature_error {
         missing_masked_byte,
         element_parse_error,
@@ -147,6 +322,22 @@ LIBHAT_EXPORT namespace hat {
         return string_to_signature(std::basic_string_view<Char>{str});
     }
 
+    /// Same as string_to_signature, but returns a small_signature which only allocates beyond N elements
+    template<std::size_t N, typename Char>
+    [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<small_signature<N>, signature_error> string_to_signature(std::basic_string_view<Char> str) {
+        if (str.empty()) {
+            return result_error{signature_error::empty_signature};
+        }
+
+        small_signature<N> result;
+        for (Char ch : str) {
+            for (const auto byte : std::bit_cast<std::array<std::byte, sizeof(Char)>>(ch)) {
+                result.emplace_back(byte);
+            }
+        }
+        return result;
+    }
+
     namespace detail {
 
         LIBHAT_CONSTEXPR_RESULT std::optional<signature_element> parse_signature_element(const std::string_view str, const std::uint8_t base) {
@@ -167,51 +358,174 @@ LIBHAT_EXPORT namespace hat {
 
             return signature_element{std::byte{value}, std::byte{mask}};
         }
-    }
 
-    [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<std::size_t, signature_error> parse_signature_to(std::output_iterator<signature_element> auto out, const std::string_view str) {
-        std::size_t written = 0;
-        bool containsByte = false;
+        /// The set of bytes matched by a byte class token
+        using byte_class = std::array<bool, 256>;
 
-        for (auto&& sub : str | std::views::split(' ')) {
-            const std::string_view word{sub.begin(), sub.end()};
-            switch (word.size()) {
-                case 0: {
-                    continue;
+        /// Calls fn with every byte matched by the masked value
+        constexpr void for_each_masked(const std::uint8_t value, const std::uint8_t mask, auto&& fn) {
+            const auto free = static_cast<std::uint8_t>(~mask);
+            for (std::uint8_t sub = free;; sub = static_cast<std::uint8_t>((sub - 1) & free)) {
+                fn(static_cast<std::uint8_t>((value & mask) | sub));
+                if (sub == 0) {
+                    break;
                 }
-                case 1: {
-                    if (word.front() != '?') {
-                        return result_error{signature_error::expected_wildcard};
+            }
+        }
+
+        constexpr bool covers(const byte_class& members, const std::uint8_t value, const std::uint8_t mask) {
+            bool result = true;
+            for_each_masked(value, mask, [&](const std::uint8_t b) {
+                result &= members[b];
+            });
+            return result;
+        }
+
+        /// Returns the smallest masked value matching every byte in the set for which pred(byte) holds
+        constexpr std::optional<std::pair<std::uint8_t, std::uint8_t>> enclose(const byte_class& members, auto&& pred) {
+            std::optional<std::uint8_t> first{};
+            std::uint8_t diff{};
+            for (std::size_t b = 0; b < members.size(); b++) {
+                const auto byte = static_cast<std::uint8_t>(b);
+                if (members[b] && pred(byte)) {
+                    if (!first) {
+                        first = byte;
                     }
-                    *out++ = signature_element{std::nullopt};
-                    written++;
-                    break;
+                    diff |= static_cast<std::uint8_t>(byte ^ *first);
                 }
-                case 2:
-                case 8: {
-                    const std::uint8_t base = word.size() == 2 ? 16 : 2;
-                    auto element = detail::parse_signature_element(word, base);
-                    if (element) {
-                        *out++ = *element;
-                        written++;
-                        containsByte |= element->all();
-                    } else {
+            }
+            if (!first) {
+                return std::nullopt;
+            }
+            const auto mask = static_cast<std::uint8_t>(~diff);
+            return std::pair{static_cast<std::uint8_t>(*first & mask), mask};
+        }
+
+        /// A byte class compiled into the smallest masked value enclosing it. If that value matches exactly the bytes
+        /// of the class, it is used as a regular element, otherwise the members are also checked separately.
+        struct compiled_byte_class {
+            signature_element enclosing{};
+            byte_class members{};
+            bool exact{};
+        };
+
+        constexpr compiled_byte_class compile_byte_class(const byte_class& members) {
+            const auto all = enclose(members, [](std::uint8_t) { return true; });
+            return {
+                signature_element{std::byte{all->first}, std::byte{all->second}},
+                members,
+                covers(members, all->first, all->second)
+            };
+        }
+
+        /// Parses a byte class token such as "[48|4C]", "[50-57]" or "[4?|50-57]". Each alternative is either a byte
+        /// in the regular hex or binary syntax, or an inclusive range of two hex bytes.
+        LIBHAT_CONSTEXPR_RESULT std::optional<compiled_byte_class> parse_byte_class(std::string_view word) {
+            if (word.size() < 3 || word.front() != '[' || word.back() != ']') {
+                return std::nullopt;
+            }
+            word = word.substr(1, word.size() - 2);
+
+            byte_class members{};
+            for (auto&& sub : word | std::views::split('|')) {
+                const std::string_view alt{sub.begin(), sub.end()};
+                if (alt.size() == 5 && alt[2] == '-') {
+                    const auto lo = hat::parse_int<std::uint8_t>(alt.substr(0, 2), 16);
+                    const auto hi = hat::parse_int<std::uint8_t>(alt.substr(3, 2), 16);
+                    if (!lo.has_value() || !hi.has_value() || lo.value() > hi.value()) {
+                        return std::nullopt;
+                    }
+                    for (std::size_t b = lo.value(); b <= hi.value(); b++) {
+                        members[b] = true;
+                    }
+                } else if (alt.size() == 2 || alt.size() == 8) {
+                    const auto element = parse_signature_element(alt, alt.size() == 2 ? 16 : 2);
+                    if (!element) {
+                        return std::nullopt;
+                    }
+                    for_each_masked(std::to_integer<std::uint8_t>(element->value()), std::to_integer<std::uint8_t>(element->mask()),
+                        [&](const std::uint8_t b) { members[b] = true; });
+                } else {
+                    return std::nullopt;
+                }
+            }
+            return compile_byte_class(members);
+        }
+
+        /// Parses a signature into the output iterator. Byte classes which a single masked value can't represent are
+        /// written as the masked value enclosing them and passed to onClass, which returns false to reject them.
+        [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<std::size_t, signature_error> parse_signature_to(std::output_iterator<signature_element> auto out, const std::string_view str, auto&& onClass) {
+            std::size_t written = 0;
+            bool containsByte = false;
+
+            for (auto&& sub : str | std::views::split(' ')) {
+                const std::string_view word{sub.begin(), sub.end()};
+                if (word.starts_with('[')) {
+                    const auto compiled = parse_byte_class(word);
+                    if (!compiled) {
                         return result_error{signature_error::element_parse_error};
                     }
-                    break;
+                    if (!compiled->exact) {
+                        signature_class cls{written};
+                        for (std::size_t b = 0; b < compiled->members.size(); b++) {
+                            if (compiled->members[b]) {
+                                cls.insert(static_cast<std::uint8_t>(b));
+                            }
+                        }
+                        if (!onClass(cls)) {
+                            return result_error{signature_error::element_parse_error};
+                        }
+                    }
+                    const auto element = compiled->enclosing;
+                    *out++ = element;
+                    written++;
+                    containsByte |= element.all();
+                    continue;
                 }
-                default: {
-                    return result_error{signature_error::invalid_token_length};
+                switch (word.size()) {
+                    case 0: {
+                        continue;
+                    }
+                    case 1: {
+                        if (word.front() != '?') {
+                            return result_error{signature_error::expected_wildcard};
+                        }
+                        *out++ = signature_element{std::nullopt};
+                        written++;
+                        break;
+                    }
+                    case 2:
+                    case 8: {
+                        const std::uint8_t base = word.size() == 2 ? 16 : 2;
+                        auto element = parse_signature_element(word, base);
+                        if (element) {
+                            *out++ = *element;
+                            written++;
+                            containsByte |= element->all();
+                        } else {
+                            return result_error{signature_error::element_parse_error};
+                        }
+                        break;
+                    }
+                    default: {
+                        return result_error{signature_error::invalid_token_length};
+                    }
                 }
             }
+            if (written == 0) {
+                return result_error{signature_error::empty_signature};
+            }
+            if (!containsByte) {
+                return result_error{signature_error::missing_masked_byte};
+            }
+            return written;
         }
-        if (written == 0) {
-            return result_error{signature_error::empty_signature};
-        }
-        if (!containsByte) {
-            return result_error{signature_error::missing_masked_byte};
-        }
-        return written;
+    }
+
+    /// Parses a signature into the output iterator, returning the number of elements written. Byte classes which
+    /// can't be represented by a single masked value are rejected, use parse_class_signature for those.
+    [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<std::size_t, signature_error> parse_signature_to(std::output_iterator<signature_element> auto out, const std::string_view str) {
+        return detail::parse_signature_to(out, str, [](const signature_class&) { return false; });
     }
 
     [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<signature, signature_error> parse_signature(std::string_view str) {
@@ -224,6 +538,190 @@ LIBHAT_EXPORT namespace hat {
 
         return result_error{result.error()};
     }
+
+    /// Same as parse_signature, but returns a small_signature which only allocates beyond N elements. For example,
+    /// parse_signature<>("48 8B 05") uses the default inline capacity.
+    template<std::size_t N = 64>
+    [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<small_signature<N>, signature_error> parse_signature(std::string_view str) {
+        small_signature<N> sig{};
+        auto result = parse_signature_to(std::back_inserter(sig), str);
+
+        if (result.has_value()) {
+            return sig;
+        }
+
+        return result_error{result.error()};
+    }
+
+    /// Same as parse_signature, but also accepts byte classes which a single masked value can't represent, such as
+    /// "[41-5A]" or "[4?|E8]"
+    [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<class_signature, signature_error> parse_class_signature(std::string_view str) {
+        class_signature sig{};
+        auto result = detail::parse_signature_to(std::back_inserter(sig.elements), str, [&](const signature_class& cls) {
+            sig.classes.push_back(cls);
+            return true;
+        });
+
+        if (result.has_value()) {
+            return sig;
+        }
+
+        return result_error{result.error()};
+    }
+
+    /// One component of a composite_signature. The component is required to start within [min_offset, max_offset]
+    /// bytes of the start of the previous component. These offsets are ignored for the first component.
+    struct composite_component {
+        signature      elements{};
+        std::ptrdiff_t min_offset{};
+        std::ptrdiff_t max_offset{};
+    };
+
+    /// A sequence of signatures separated by variable distances, matched as a single pattern. The scanner searches for
+    /// the most selective component, and then verifies the remaining components within their bounded windows.
+    class composite_signature {
+    public:
+        constexpr composite_signature() = default;
+
+        /// Appends a component which must start within [minOffset, maxOffset] bytes of the previous component's start.
+        /// The offsets may be negative, allowing the component to appear before the previous one.
+        constexpr composite_signature& append(signature elements, const std::ptrdiff_t minOffset, const std::ptrdiff_t maxOffset) {
+            this->components_.push_back({std::move(elements), minOffset, maxOffset});
+            return *this;
+        }
+
+        /// Appends a component which must start between minGap and maxGap bytes after the previous component ends
+        constexpr composite_signature& append_after(signature elements, const std::size_t minGap, const std::size_t maxGap) {
+            const auto previous = this->components_.empty() ? 0 : static_cast<std::ptrdiff_t>(this->components_.back().elements.size());
+            return this->append(std::move(elements),
+                previous + static_cast<std::ptrdiff_t>(minGap),
+                previous + static_cast<std::ptrdiff_t>(maxGap));
+        }
+
+        /// Appends a component which must start within "distance" bytes of the previous component's start, in either
+        /// direction.
+        constexpr composite_signature& append_near(signature elements, const std::size_t distance) {
+            const auto d = static_cast<std::ptrdiff_t>(distance);
+            return this->append(std::move(elements), -d, d);
+        }
+
+        [[nodiscard]] constexpr std::span<const composite_component> components() const noexcept {
+            return this->components_;
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept {
+            return this->components_.size();
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return this->components_.empty();
+        }
+
+    private:
+        std::vector<composite_component> components_{};
+    };
+
+    namespace detail {
+
+        enum class gap_kind {
+            none,
+            after, // [n] or [n-m], a gap after the end of the previous component
+            near,  // [~n], within n bytes of the previous component's start
+        };
+
+        struct gap_token {
+            gap_kind    kind{};
+            std::size_t min{};
+            std::size_t max{};
+        };
+
+        LIBHAT_CONSTEXPR_RESULT std::optional<gap_token> parse_gap_token(const std::string_view token) {
+            if (token.size() < 3 || token.front() != '[' || token.back() != ']') {
+                return gap_token{};
+            }
+            auto word = token.substr(1, token.size() - 2);
+            if (word.find_first_not_of("0123456789-~") != std::string_view::npos) {
+                // Not a gap, but possibly a byte class
+                return gap_token{};
+            }
+
+            const bool near = word.front() == '~';
+            if (near) {
+                word.remove_prefix(1);
+            }
+            const auto dash = word.find('-');
+            if (near && dash != std::string_view::npos) {
+                return std::nullopt;
+            }
+
+            const auto min = hat::parse_int<std::size_t>(word.substr(0, dash));
+            const auto max = dash == std::string_view::npos ? min : hat::parse_int<std::size_t>(word.substr(dash + 1));
+            if (!min.has_value() || !max.has_value() || min.value() > max.value()) {
+                return std::nullopt;
+            }
+            if (!near && parse_byte_class(token)) {
+                // Tokens such as [10] or [50-57] are also valid byte classes
+                return std::nullopt;
+            }
+            return gap_token{near ? gap_kind::near : gap_kind::after, min.value(), max.value()};
+        }
+    }
+
+    /// Parses a composite signature. Components use the regular signature syntax, and are separated by a gap token:
+    /// - "[n]" the next component starts exactly n bytes after the end of the previous one
+    /// - "[n-m]" the next component starts between n and m bytes after the end of the previous one
+    /// - "[~n]" the next component starts within n bytes of the start of the previous one, in either direction
+    /// All numbers are decimal. For example, "48 8B 05 [4-12] E8" matches a call instruction between 4 and 12 bytes
+    /// after the "48 8B 05" bytes. Byte classes may be used within components, but a token which is both a valid gap
+    /// and a valid byte class, such as "[10]" or "[50-57]", is rejected as ambiguous. Write such a gap with a leading
+    /// zero, as in "[010-020]", and such a class with alternatives or in binary, as in "[01010???]". Byte classes which
+    /// a single masked value can't represent aren't supported in composite signatures.
+    [[nodiscard]] LIBHAT_CONSTEXPR_RESULT result<composite_signature, signature_error> parse_composite_signature(const std::string_view str) {
+        composite_signature composite{};
+        detail::gap_token gap{};
+
+        const auto flush = [&](const std::string_view component) -> std::optional<signature_error> {
+            auto parsed = parse_signature(component);
+            if (!parsed.has_value()) {
+                return parsed.error();
+            }
+            switch (gap.kind) {
+                case detail::gap_kind::none:
+                    composite.append(std::move(parsed).value(), 0, 0);
+                    break;
+                case detail::gap_kind::after:
+                    composite.append_after(std::move(parsed).value(), gap.min, gap.max);
+                    break;
+                case detail::gap_kind::near:
+                    composite.append_near(std::move(parsed).value(), gap.max);
+                    break;
+            }
+            return std::nullopt;
+        };
+
+        std::size_t componentBegin = 0;
+        for (auto&& sub : str | std::views::split(' ')) {
+            const std::string_view word{sub.begin(), sub.end()};
+            const auto token = detail::parse_gap_token(word);
+            if (!token) {
+                return result_error{signature_error::element_parse_error};
+            }
+            if (token->kind == detail::gap_kind::none) {
+                continue;
+            }
+
+            const auto wordBegin = static_cast<std::size_t>(word.data() - str.data());
+            if (const auto error = flush(str.substr(componentBegin, wordBegin - componentBegin))) {
+                return result_error{*error};
+            }
+            gap = *token;
+            componentBegin = wordBegin + word.size();
+        }
+        if (const auto error = flush(str.substr(componentBegin))) {
+            return result_error{*error};
+        }
+        return composite;
+    }
 }
 
 namespace hat::detail {
@@ -254,34 +752,83 @@ LIBHAT_EXPORT namespace hat {
     }
 #endif
 
+    namespace detail {
+
+        /// Appends an element in the hex syntax, or in binary if its mask doesn't cover whole nibbles
+        constexpr void append_element(std::string& ret, const signature_element element) {
+            constexpr std::string_view hex{"0123456789ABCDEF"};
+            const auto value = element.value();
+            const auto mask = element.mask();
+            const bool a = (mask & std::byte{0xF0}) == std::byte{0xF0};
+            const bool b = (mask & std::byte{0x0F}) == std::byte{0x0F};
+            const bool wholeNibbles = (a || (mask & std::byte{0xF0}) == std::byte{0x00})
+                                   && (b || (mask & std::byte{0x0F}) == std::byte{0x00});
+            if ((a || b) && wholeNibbles) {
+                ret += {
+                    a ? hex[static_cast<std::size_t>(value >> 4) & 0xFu] : '?',
+                    b ? hex[static_cast<std::size_t>(value >> 0) & 0xFu] : '?'
+                };
+            } else if (mask == std::byte{0x00}) {
+                ret += '?';
+            } else {
+                for (int bit = 7; bit >= 0; bit--) {
+                    const auto m = std::byte{1} << bit;
+                    ret += (mask & m) != std::byte{0} ? ((value & m) != std::byte{0} ? '1' : '0') : '?';
+                }
+            }
+        }
+    }
+
+    namespace detail {
+
+        /// Appends a byte class as its runs of consecutive bytes, such as "[41-5A|61-7A]"
+        constexpr void append_class(std::string& ret, const signature_class& cls) {
+            ret += '[';
+            for (std::size_t b = 0; b < 256;) {
+                if (!(cls == std::byte(b))) {
+                    b++;
+                    continue;
+                }
+                const auto lo = b;
+                while (b < 256 && cls == std::byte(b)) {
+                    b++;
+                }
+                if (ret.back() != '[') {
+                    ret += '|';
+                }
+                detail::append_element(ret, std::byte(lo));
+                if (b - 1 != lo) {
+                    ret += '-';
+                    detail::append_element(ret, std::byte(b - 1));
+                }
+            }
+            ret += ']';
+        }
+    }
+
     [[nodiscard]] constexpr std::string to_string(const signature_view signature) {
-        constexpr std::string_view hex{"0123456789ABCDEF"};
         std::string ret;
         ret.reserve(signature.size() * 3);
         for (auto& element : signature) {
-            const bool a = (element.mask() & std::byte{0xF0}) == std::byte{0xF0};
-            const bool b = (element.mask() & std::byte{0x0F}) == std::byte{0x0F};
-            if (a || b) {
-                ret += {
-                    a ? hex[static_cast<std::size_t>(element.value() >> 4) & 0xFu] : '?',
-                    b ? hex[static_cast<std::size_t>(element.value() >> 0) & 0xFu] : '?',
-                    ' '
-                };
-            } else if (element.none()) {
-                ret += "? ";
+            detail::append_element(ret, element);
+            ret += ' ';
+        }
+        ret.pop_back();
+        return ret;
+    }
+
+    [[nodiscard]] constexpr std::string to_string(const class_signature& signature) {
+        std::string ret;
+        ret.reserve(signature.elements.size() * 3);
+        auto cls = signature.classes.begin();
+        for (std::size_t i = 0; i < signature.elements.size(); i++) {
+            if (cls != signature.classes.end() && cls->index == i) {
+                detail::append_class(ret, *cls);
+                ++cls;
             } else {
-                ret += {
-                    element.has(7) ? (element.at(7) ? '1' : '0') : '?',
-                    element.has(6) ? (element.at(6) ? '1' : '0') : '?',
-                    element.has(5) ? (element.at(5) ? '1' : '0') : '?',
-                    element.has(4) ? (element.at(4) ? '1' : '0') : '?',
-                    element.has(3) ? (element.at(3) ? '1' : '0') : '?',
-                    element.has(2) ? (element.at(2) ? '1' : '0') : '?',
-                    element.has(1) ? (element.at(1) ? '1' : '0') : '?',
-                    element.has(0) ? (element.at(0) ? '1' : '0') : '?',
-                    ' '
-                };
+                detail::append_element(ret, signature.elements[i]);
             }
+            ret += ' ';
         }
         ret.pop_back();
         return ret;
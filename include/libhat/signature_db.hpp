@@ -0,0 +1,86 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <filesystem>
+    #include <memory>
+    #include <optional>
+    #include <span>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "batch.hpp"
+#include "export.hpp"
+#include "result.hpp"
+#include "scanner.hpp"
+#include "signature.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    /// A signature in its text form, to be compiled into a signature database
+    struct signature_db_source {
+        std::string_view name{};
+        std::string_view signature{};
+        std::string_view section{};
+        scan_alignment alignment = scan_alignment::X1;
+        scan_hint hints = scan_hint::none;
+    };
+
+    struct signature_db_error {
+        std::size_t index{}; // The source which couldn't be parsed
+        signature_error error{};
+    };
+
+    struct signature_db_entry {
+        std::string_view name{};
+        signature_view signature{};
+        std::string_view section{};
+        scan_alignment alignment = scan_alignment::X1;
+        scan_hint hints = scan_hint::none;
+
+        [[nodiscard]] scan_request to_request() const noexcept {
+            return {this->signature, this->section, this->alignment, this->hints};
+        }
+    };
+
+    /// Parses the signatures and packs them into the binary format read by signature_db. The elements of each
+    /// signature are stored as-is, so loading the database doesn't parse or allocate anything per signature. The
+    /// format uses the host's byte order.
+    [[nodiscard]] result<std::vector<std::byte>, signature_db_error> compile_signature_db(
+        std::span<const signature_db_source> sources
+    );
+
+    /// A read-only set of named signatures in the binary format produced by compile_signature_db. The views returned
+    /// by the database point into its data, and stay valid as long as a copy of the database exists.
+    class signature_db {
+    public:
+        /// Memory maps a database file. Returns std::nullopt if the file is missing or isn't a valid database.
+        [[nodiscard]] static std::optional<signature_db> open(const std::filesystem::path& path);
+
+        /// Uses a database in memory, such as one embedded in the binary, without copying it. The data must outlive
+        /// the database. Returns std::nullopt if it isn't a valid database.
+        [[nodiscard]] static std::optional<signature_db> from_bytes(std::span<const std::byte> data);
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return this->count;
+        }
+
+        /// Returns the entry at an index, entries are sorted by name
+        [[nodiscard]] signature_db_entry operator[](std::size_t index) const noexcept;
+
+        /// Returns the entry with the given name, or std::nullopt if there isn't one
+        [[nodiscard]] std::optional<signature_db_entry> find(std::string_view name) const noexcept;
+
+        /// Returns a scan request for every entry, in the order of the entries
+        [[nodiscard]] std::vector<scan_request> requests() const;
+
+    private:
+        signature_db(std::shared_ptr<const void> owner, std::span<const std::byte> data, std::size_t count)
+            : owner(std::move(owner)), data(data), count(count) {}
+
+        std::shared_ptr<const void> owner{};
+        std::span<const std::byte> data{};
+        std::size_t count{};
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <string_view>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+#include "result.hpp"
+#include "signature.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    struct signature_list_error {
+        std::size_t line{}; // The zero-based line which couldn't be parsed
+        signature_error error{};
+    };
+
+    /// Many signatures parsed from one text, with their elements stored back to back
+    class signature_list {
+    public:
+        [[nodiscard]] std::size_t size() const noexcept {
+            return this->lines.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return this->lines.empty();
+        }
+
+        [[nodiscard]] signature_view operator[](const std::size_t index) const noexcept {
+            return signature_view{this->elements}.subspan(this->offsets[index], this->offsets[index + 1] - this->offsets[index]);
+        }
+
+        /// The zero-based line of the text that the signature at an index was parsed from
+        [[nodiscard]] std::size_t line(const std::size_t index) const noexcept {
+            return this->lines[index];
+        }
+
+    private:
+        friend result<signature_list, signature_list_error> parse_signature_list(std::string_view text);
+
+        std::vector<signature_element> elements{};
+        std::vector<std::size_t> offsets{0};
+        std::vector<std::size_t> lines{};
+    };
+
+    /// Parses a signature from each line of the text, in the syntax accepted by parse_signature. Lines which are empty
+    /// or only contain spaces are skipped, and a trailing carriage return is ignored. The text is classified with SIMD
+    /// where available, and lines which only contain hex bytes and wildcards are parsed without going through
+    /// parse_signature. Returns the first line that fails to parse, along with the error parse_signature gives for it.
+    [[nodiscard]] result<signature_list, signature_list_error> parse_signature_list(std::string_view text);
+}
@@ -1,15 +1,46 @@
 #pragma once
 
 #ifndef LIBHAT_MODULE
+    #include <cstdint>
     #include <string>
+    #include <vector>
 #endif
 
 #include "defines.hpp"
 #include "export.hpp"
 
 LIBHAT_EXPORT namespace hat {
+
+    /// The kind of a core on CPUs which mix core designs, such as Intel's P/E-cores or ARM's big.LITTLE
+    enum class cpu_core_type : std::uint8_t {
+        unknown,     // Not a hybrid CPU, or the OS doesn't report it
+        performance,
+        efficiency,
+    };
+
+    struct cpu_core_info {
+        std::size_t logical_id{};  // The OS's index of the logical processor
+        std::size_t physical_id{}; // Shared by the logical processors (SMT threads) of a physical core
+        std::size_t numa_node{};
+        cpu_core_type type{};
+    };
+
+    /// Cache sizes in bytes of the first logical processor, zero for levels that aren't present or reported
+    struct cpu_cache_info {
+        std::size_t l1d_size{};
+        std::size_t l2_size{};
+        std::size_t l3_size{};
+        std::size_t line_size{};
+    };
+
     struct system_info {
         std::size_t page_size{};
+        std::size_t physical_cores{};
+        std::size_t logical_cores{};
+        std::size_t numa_nodes{};
+        bool hybrid{};                     // Whether the cores have different cpu_core_types
+        cpu_cache_info caches{};
+        std::vector<cpu_core_info> cores{}; // One per logical processor, may be empty if the OS doesn't report them
 
         system_info(const system_info&) = delete;
         system_info& operator=(const system_info&) = delete;
@@ -34,8 +65,11 @@ LIBHAT_EXPORT namespace hat {
         bool avx2 : 1;
         bool avx512f : 1;
         bool avx512bw : 1;
+        bool avx512vl : 1;
+        bool avx512vbmi : 1;
         bool popcnt : 1;
         bool bmi : 1;
+        bool bmi2 : 1;
     };
 
     struct system_info_x86 : hat::system_info {
@@ -99,6 +133,16 @@ LIBHAT_EXPORT namespace hat {
 #else
         .avx512bw = false,
 #endif
+#if defined(__AVX512VL__)
+        .avx512vl = true,
+#else
+        .avx512vl = false,
+#endif
+#if defined(__AVX512VBMI__)
+        .avx512vbmi = true,
+#else
+        .avx512vbmi = false,
+#endif
 #if defined(__POPCNT__)
         .popcnt = true,
 #else
@@ -108,6 +152,11 @@ LIBHAT_EXPORT namespace hat {
         .bmi = true,
 #else
         .bmi = false,
+#endif
+#if defined(__BMI2__)
+        .bmi2 = true,
+#else
+        .bmi2 = false,
 #endif
     };
 
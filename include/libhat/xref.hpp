@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef LIBHAT_MODULE
+    #include <cstddef>
+    #include <cstdint>
+    #include <span>
+    #include <vector>
+#endif
+
+#include "export.hpp"
+
+LIBHAT_EXPORT namespace hat {
+
+    enum class xref_kind : std::uint8_t {
+        call,          // E8 rel32
+        jmp,           // E9 rel32
+        jcc,           // 0F 80-8F rel32
+        lea,           // 8D /r with a RIP relative operand
+        mov,           // 89 /r and 8B /r with a RIP relative operand
+        call_indirect, // FF 15, the target is the address of the called pointer
+        jmp_indirect,  // FF 25, the target is the address of the jumped to pointer
+
+        bl,            // AArch64 BL
+        b,             // AArch64 B
+        adrp_add,      // AArch64 ADRP followed by an ADD of the low 12 bits
+        adrp_ldr,      // AArch64 ADRP followed by a load with the register as its base
+        adrp_str,      // AArch64 ADRP followed by a store with the register as its base
+    };
+
+    /// An instruction referring to a target address relative to its own address
+    struct xref {
+        const std::byte* instruction{}; // The first byte of the instruction, including a REX prefix, or the ADRP
+        std::uintptr_t target{};
+        xref_kind kind{};
+
+        [[nodiscard]] constexpr auto operator<=>(const xref&) const noexcept = default;
+    };
+
+    /// Finds the x86_64 instructions in "data" which refer to "target", ordered by the position of their displacement.
+    /// The displacement at every byte position is added to its address in bulk, and only the positions which resolve
+    /// to the target and follow one of the opcodes of xref_kind are decoded. Like scanning for the opcodes, this doesn't
+    /// disassemble the data, so an instruction may be found within the bytes of another.
+    [[nodiscard]] std::vector<xref> find_xrefs(std::span<const std::byte> data, std::uintptr_t target);
+
+    /// Same as above, finding the references to any of a set of targets, which must be sorted in ascending order. The
+    /// data is only scanned once regardless of the number of targets.
+    [[nodiscard]] std::vector<xref> find_xrefs(std::span<const std::byte> data, std::span<const std::uintptr_t> targets);
+
+    /// Finds the AArch64 instructions in "data" which refer to "target", in ascending order. The branch and page targets
+    /// of all instruction words are computed in bulk, and only the BL, B and ADRP instructions which can resolve to the
+    /// target are decoded. The page offset of an ADRP is taken from the first of the next 8 instructions which uses its
+    /// register as a base, if that is an ADD or a load or store with an unsigned offset.
+    [[nodiscard]] std::vector<xref> find_xrefs_aarch64(std::span<const std::byte> data, std::uintptr_t target);
+
+    /// Same as above, finding the references to any of a set of targets, which must be sorted in ascending order. The
+    /// data is only scanned once regardless of the number of targets.
+    [[nodiscard]] std::vector<xref> find_xrefs_aarch64(std::span<const std::byte> data, std::span<const std::uintptr_t> targets);
+}
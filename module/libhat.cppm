@@ -9,13 +9,16 @@ module;
 #ifndef LIBHAT_USE_STD_MODULE
     #include <algorithm>
     #include <array>
+    #include <atomic>
     #include <bit>
+    #include <chrono>
     #include <concepts>
     #include <cstddef>
     #include <cstdint>
     #include <cstdlib>
     #include <cstring>
     #include <execution>
+    #include <filesystem>
     #include <functional>
     #include <iterator>
     #include <memory>
@@ -28,6 +31,7 @@ module;
     #include <string_view>
     #include <tuple>
     #include <type_traits>
+    #include <unordered_map>
     #include <utility>
     #include <variant>
     #include <vector>
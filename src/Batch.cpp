@@ -0,0 +1,131 @@
+#include <libhat/batch.hpp>
+#include <libhat/system.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+
+namespace hat::detail {
+
+    static constexpr std::size_t min_block_size = 64 * 1024;
+    static constexpr std::size_t fallback_block_size = 256 * 1024;
+
+    /// Half of the L2 cache, leaving room for the rest of the working set of the thread and its SMT sibling
+    static std::size_t get_default_block_size() {
+        const auto l2 = get_system().caches.l2_size;
+        return l2 ? std::max(l2 / 2, min_block_size) : fallback_block_size;
+    }
+
+    /// One thread per physical performance core, the efficiency cores would leave their blocks for last
+    static std::size_t get_default_thread_count() {
+        const auto& system = get_system();
+        std::set<std::size_t> physical{};
+        for (const auto& core : system.cores) {
+            if (core.type != cpu_core_type::efficiency) {
+                physical.insert(core.physical_id);
+            }
+        }
+        if (!physical.empty()) {
+            return physical.size();
+        }
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    struct section_batch {
+        std::span<const std::byte> data{};
+        std::vector<std::size_t> requests{}; // Indices of the requests targeting this section
+        std::size_t blocks{};
+        std::size_t firstItem{};             // Index of the first block in the combined list of work items
+    };
+}
+
+namespace hat {
+
+    std::vector<scan_result> resolve_all(
+        const std::span<const scan_request> requests,
+        const process::module&              mod,
+        const batch_options&                options
+    ) {
+        const auto blockSize = std::max<std::size_t>(options.block_size ? options.block_size : detail::get_default_block_size(), 1);
+
+        // Each distinct section is only looked up once
+        std::vector<detail::section_batch> sections{};
+        std::vector<detail::scan_context> contexts{};
+        contexts.reserve(requests.size());
+        for (std::size_t i = 0; i < requests.size(); i++) {
+            const auto& request = requests[i];
+            contexts.push_back(detail::scan_context::create(request.signature, request.alignment, request.hints));
+
+            auto it = std::ranges::find_if(sections, [&](const detail::section_batch& batch) {
+                return requests[batch.requests.front()].section == request.section;
+            });
+            if (it == sections.end()) {
+                it = sections.insert(sections.end(), {.data = mod.get_section_data(request.section)});
+            }
+            it->requests.push_back(i);
+        }
+
+        std::size_t items{};
+        for (auto& section : sections) {
+            section.blocks = (section.data.size() + blockSize - 1) / blockSize;
+            section.firstItem = items;
+            items += section.blocks;
+        }
+
+        // The lowest address each request matched at so far. Blocks are handed out in ascending order, so a request
+        // usually stops being scanned soon after its first match.
+        std::vector<std::atomic<const std::byte*>> matches(requests.size());
+        std::atomic<std::size_t> nextItem{};
+
+        const auto worker = [&] {
+            auto section = sections.begin();
+            for (auto item = nextItem++; item < items; item = nextItem++) {
+                while (item >= section->firstItem + section->blocks) {
+                    section++;
+                }
+                const auto data = section->data;
+                const auto offset = (item - section->firstItem) * blockSize;
+                const auto blockBegin = data.data() + offset;
+                const auto blockEnd = data.data() + std::min(offset + blockSize, data.size());
+
+                for (const auto index : section->requests) {
+                    auto& match = matches[index];
+                    const auto* best = match.load(std::memory_order_relaxed);
+                    if (best && best < blockBegin) {
+                        continue;
+                    }
+
+                    // Extend the range so that matches starting in this block but ending in the next one are found
+                    const auto& context = contexts[index];
+                    const auto available = static_cast<std::size_t>(data.data() + data.size() - blockEnd);
+                    const auto end = blockEnd + std::min(context.signature.size() ? context.signature.size() - 1 : 0, available);
+                    const auto result = context.scan(blockBegin, end);
+                    if (!result.has_result()) {
+                        continue;
+                    }
+
+                    const auto address = result.get();
+                    while ((!best || address < best) && !match.compare_exchange_weak(best, address, std::memory_order_relaxed)) {}
+                }
+            }
+        };
+
+        const auto threads = std::min(options.threads ? options.threads : detail::get_default_thread_count(), items);
+        std::vector<std::thread> pool{};
+        for (std::size_t i = 1; i < threads; i++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        std::vector<scan_result> results{};
+        results.reserve(requests.size());
+        for (const auto& match : matches) {
+            results.emplace_back(const_cast<std::byte*>(match.load(std::memory_order_relaxed)));
+        }
+        return results;
+    }
+}
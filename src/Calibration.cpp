@@ -0,0 +1,216 @@
+#include <libhat/calibration.hpp>
+
+#include <libhat/system.hpp>
+
+#include "Utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace hat::detail {
+
+    static constexpr std::array<std::pair<scan_mode, std::string_view>, 9> scan_mode_names{{
+        {scan_mode::Auto, "Auto"},
+        {scan_mode::Single, "Single"},
+        {scan_mode::SWAR, "SWAR"},
+        {scan_mode::Horspool, "Horspool"},
+        {scan_mode::SSE, "SSE"},
+        {scan_mode::AVX2, "AVX2"},
+        {scan_mode::AVX512, "AVX512"},
+        {scan_mode::AVX512VL, "AVX512VL"},
+        {scan_mode::Neon, "Neon"},
+    }};
+
+    static constexpr std::string_view calibration_header = "libhat-scan-calibration 1";
+
+    // A buffer size that's representative of each size class
+    static constexpr std::array<std::size_t, scan_size_class_count> calibration_sizes{
+        std::size_t{16} << 10,
+        std::size_t{1} << 20,
+        std::size_t{8} << 20,
+    };
+
+    static constexpr std::size_t calibration_rounds = 3;
+
+    /// Identifies the host CPU for cached calibrations, or returns an empty string if it can't be identified, in which
+    /// case calibrations aren't cached
+    static std::string get_cpu_identifier() {
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        return get_system().cpu_brand;
+#elif defined(LIBHAT_LINUX)
+        // The fields of the MIDR register of each core, which identify its design and revision. Cores of different
+        // designs are listed once each.
+        std::ifstream file{"/proc/cpuinfo"};
+        std::vector<std::string> cores{};
+        std::string core{};
+        for (std::string line; std::getline(file, line);) {
+            if (line.starts_with("CPU implementer") || line.starts_with("CPU variant")
+                || line.starts_with("CPU part") || line.starts_with("CPU revision")) {
+                const auto colon = line.find(':');
+                core += colon == std::string::npos ? line : line.substr(colon + 1);
+            } else if (line.empty() && !core.empty()) {
+                cores.push_back(std::exchange(core, {}));
+            }
+        }
+        if (!core.empty()) {
+            cores.push_back(std::move(core));
+        }
+        std::ranges::sort(cores);
+        const auto [first, last] = std::ranges::unique(cores);
+        cores.erase(first, last);
+
+        std::string id{};
+        for (const auto& entry : cores) {
+            id += id.empty() ? "arm" : ";";
+            id += entry;
+        }
+        return id;
+#else
+        return {};
+#endif
+    }
+
+    static std::chrono::steady_clock::duration measure(const scan_context& context, const std::span<const std::byte> buffer,
+        const std::size_t bytes) {
+        const auto repetitions = std::max<std::size_t>(1, bytes / buffer.size());
+        auto best = std::chrono::steady_clock::duration::max();
+        for (std::size_t round = 0; round < calibration_rounds; round++) {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < repetitions; i++) {
+                const auto result = context.scan(buffer.data(), buffer.data() + buffer.size());
+                if (result.has_result()) LIBHAT_UNLIKELY {
+                    break;
+                }
+            }
+            best = std::min(best, std::chrono::steady_clock::now() - start);
+        }
+        return best;
+    }
+
+    struct pending_calibration {
+        std::once_flag enable{};
+        std::once_flag once{};
+        std::atomic<bool> enabled{};
+        std::filesystem::path cache{};
+    };
+
+    static pending_calibration& get_pending_calibration() {
+        static pending_calibration pending{};
+        return pending;
+    }
+
+    void run_pending_scan_calibration() {
+        auto& pending = get_pending_calibration();
+        if (!pending.enabled.load(std::memory_order_acquire)) LIBHAT_LIKELY {
+            return;
+        }
+        std::call_once(pending.once, [&] {
+            if (!pending.cache.empty()) {
+                if (const auto cached = load_scan_calibration(pending.cache)) {
+                    apply_scan_calibration(*cached);
+                    return;
+                }
+            }
+            const auto calibration = calibrate_scan_modes();
+            apply_scan_calibration(calibration);
+            if (!pending.cache.empty()) {
+                save_scan_calibration(calibration, pending.cache);
+            }
+        });
+    }
+}
+
+namespace hat {
+
+    scan_calibration calibrate_scan_modes(const std::size_t bytes) {
+        std::vector<std::byte> buffer(std::clamp<std::size_t>(bytes, 1, detail::calibration_sizes.back()));
+        std::minstd_rand generator{0x6C696268}; // NOLINT(cert-msc51-cpp)
+        std::ranges::generate(buffer, [&] { return static_cast<std::byte>(generator() >> 8); });
+
+        // A typical pattern which doesn't occur in the buffer, so every scan covers the whole range
+        const auto signature = parse_signature("48 8B 05 ? ? ? ? 48 89 5C 24").value();
+        const auto base = detail::scan_context::create<scan_mode::Single>(signature, scan_alignment::X1, scan_hint::none);
+
+        scan_calibration calibration{};
+        calibration.cpu = detail::get_cpu_identifier();
+        for (std::size_t sizeClass = 0; sizeClass < scan_size_class_count; sizeClass++) {
+            const std::span<const std::byte> range{buffer.data(), std::min(buffer.size(), detail::calibration_sizes[sizeClass])};
+
+            auto best = std::chrono::steady_clock::duration::max();
+            calibration.modes[sizeClass] = scan_mode::Single;
+            for (const auto mode : {scan_mode::Single, scan_mode::SWAR, scan_mode::SSE, scan_mode::AVX2, scan_mode::AVX512,
+                scan_mode::AVX512VL, scan_mode::Neon}) {
+                if (!is_scan_mode_supported(mode)) {
+                    continue;
+                }
+                auto context = base;
+                context.scanner = detail::resolve_scanner_for(mode, context);
+                if (const auto elapsed = detail::measure(context, range, bytes); elapsed < best) {
+                    best = elapsed;
+                    calibration.modes[sizeClass] = mode;
+                }
+            }
+        }
+        return calibration;
+    }
+
+    void apply_scan_calibration(const scan_calibration& calibration) {
+        for (std::size_t sizeClass = 0; sizeClass < scan_size_class_count; sizeClass++) {
+            set_preferred_scan_mode(static_cast<scan_size_class>(sizeClass), calibration.modes[sizeClass]);
+        }
+    }
+
+    bool save_scan_calibration(const scan_calibration& calibration, const std::filesystem::path& path) {
+        if (calibration.cpu.empty()) {
+            return false;
+        }
+        std::ofstream file{path, std::ios::trunc};
+        if (!file) {
+            return false;
+        }
+        file << detail::calibration_header << '\n' << calibration.cpu << '\n';
+        for (const auto mode : calibration.modes) {
+            const auto it = std::ranges::find(detail::scan_mode_names, mode, &std::pair<scan_mode, std::string_view>::first);
+            file << it->second << ' ';
+        }
+        file << '\n';
+        return static_cast<bool>(file);
+    }
+
+    std::optional<scan_calibration> load_scan_calibration(const std::filesystem::path& path) {
+        std::ifstream file{path};
+        std::string header;
+        scan_calibration calibration{};
+        if (!std::getline(file, header) || header != detail::calibration_header
+            || !std::getline(file, calibration.cpu) || calibration.cpu.empty()
+            || calibration.cpu != detail::get_cpu_identifier()) {
+            return std::nullopt;
+        }
+        for (auto& mode : calibration.modes) {
+            std::string name;
+            if (!(file >> name)) {
+                return std::nullopt;
+            }
+            const auto it = std::ranges::find(detail::scan_mode_names, name, &std::pair<scan_mode, std::string_view>::second);
+            if (it == detail::scan_mode_names.end() || !is_scan_mode_supported(it->first)) {
+                return std::nullopt;
+            }
+            mode = it->first;
+        }
+        return calibration;
+    }
+
+    void enable_scan_calibration(std::filesystem::path cache) {
+        // The cache path is only read once enabled is set, and it's never written again after that
+        auto& pending = detail::get_pending_calibration();
+        std::call_once(pending.enable, [&] {
+            pending.cache = std::move(cache);
+            pending.enabled.store(true, std::memory_order_release);
+        });
+    }
+}
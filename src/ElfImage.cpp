@@ -0,0 +1,282 @@
+#include <libhat/elf_image.hpp>
+
+#include "MappedFile.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace hat::detail {
+
+    static constexpr std::array<std::byte, 4> elf_magic{std::byte{0x7F}, std::byte{'E'}, std::byte{'L'}, std::byte{'F'}};
+    static constexpr std::size_t elf_ident_class = 4;
+    static constexpr std::size_t elf_ident_data = 5;
+    static constexpr std::byte elf_class_32{1};
+    static constexpr std::byte elf_class_64{2};
+    static constexpr std::byte elf_data_little_endian{1};
+
+    static constexpr std::uint32_t elf_pt_load = 1;
+    static constexpr std::uint32_t elf_sht_nobits = 8;
+    static constexpr std::uint16_t elf_pn_xnum = 0xFFFF;
+    static constexpr std::uint16_t elf_shn_xindex = 0xFFFF;
+
+    // The layouts of the headers in <elf.h>, which isn't available outside of Unix
+    struct elf_layout_64 {
+        struct ehdr {
+            std::array<std::byte, 16> ident;
+            std::uint16_t type;
+            std::uint16_t machine;
+            std::uint32_t version;
+            std::uint64_t entry;
+            std::uint64_t phoff;
+            std::uint64_t shoff;
+            std::uint32_t flags;
+            std::uint16_t ehsize;
+            std::uint16_t phentsize;
+            std::uint16_t phnum;
+            std::uint16_t shentsize;
+            std::uint16_t shnum;
+            std::uint16_t shstrndx;
+        };
+        struct phdr {
+            std::uint32_t type;
+            std::uint32_t flags;
+            std::uint64_t offset;
+            std::uint64_t vaddr;
+            std::uint64_t paddr;
+            std::uint64_t filesz;
+            std::uint64_t memsz;
+            std::uint64_t align;
+        };
+        struct shdr {
+            std::uint32_t name;
+            std::uint32_t type;
+            std::uint64_t flags;
+            std::uint64_t addr;
+            std::uint64_t offset;
+            std::uint64_t size;
+            std::uint32_t link;
+            std::uint32_t info;
+            std::uint64_t addralign;
+            std::uint64_t entsize;
+        };
+    };
+
+    struct elf_layout_32 {
+        struct ehdr {
+            std::array<std::byte, 16> ident;
+            std::uint16_t type;
+            std::uint16_t machine;
+            std::uint32_t version;
+            std::uint32_t entry;
+            std::uint32_t phoff;
+            std::uint32_t shoff;
+            std::uint32_t flags;
+            std::uint16_t ehsize;
+            std::uint16_t phentsize;
+            std::uint16_t phnum;
+            std::uint16_t shentsize;
+            std::uint16_t shnum;
+            std::uint16_t shstrndx;
+        };
+        struct phdr {
+            std::uint32_t type;
+            std::uint32_t offset;
+            std::uint32_t vaddr;
+            std::uint32_t paddr;
+            std::uint32_t filesz;
+            std::uint32_t memsz;
+            std::uint32_t flags;
+            std::uint32_t align;
+        };
+        struct shdr {
+            std::uint32_t name;
+            std::uint32_t type;
+            std::uint32_t flags;
+            std::uint32_t addr;
+            std::uint32_t offset;
+            std::uint32_t size;
+            std::uint32_t link;
+            std::uint32_t info;
+            std::uint32_t addralign;
+            std::uint32_t entsize;
+        };
+    };
+
+    static_assert(sizeof(elf_layout_64::ehdr) == 64 && sizeof(elf_layout_64::phdr) == 56 && sizeof(elf_layout_64::shdr) == 64);
+    static_assert(sizeof(elf_layout_32::ehdr) == 52 && sizeof(elf_layout_32::phdr) == 32 && sizeof(elf_layout_32::shdr) == 40);
+
+    /// Returns the part of the file in [offset, offset + size), clipped to the end of the file
+    static std::span<const std::byte> clip(const std::span<const std::byte> file, const std::uint64_t offset, const std::uint64_t size) {
+        if (offset >= file.size() || size == 0) {
+            return {};
+        }
+        return file.subspan(static_cast<std::size_t>(offset), static_cast<std::size_t>(std::min<std::uint64_t>(size, file.size() - offset)));
+    }
+}
+
+namespace hat {
+
+    std::optional<elf_image> elf_image::open(const std::filesystem::path& path) {
+        auto file = std::make_shared<detail::mapped_file>(path);
+        const auto data = file->data();
+        if (elf_image image{std::move(file), data}; image.parse()) {
+            return image;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<elf_image> elf_image::from_bytes(const std::span<const std::byte> data) {
+        if (elf_image image{nullptr, data}; image.parse()) {
+            return image;
+        }
+        return std::nullopt;
+    }
+
+    bool elf_image::parse() {
+        std::array<std::byte, 6> ident{};
+        if (!detail::read_at(this->file, 0, ident) || !std::ranges::equal(std::span{ident}.first<4>(), detail::elf_magic)) {
+            return false;
+        }
+        if (ident[detail::elf_ident_data] != detail::elf_data_little_endian) {
+            return false;
+        }
+        if (ident[detail::elf_ident_class] == detail::elf_class_64) {
+            this->class64 = true;
+            return this->parse<detail::elf_layout_64>();
+        }
+        if (ident[detail::elf_ident_class] == detail::elf_class_32) {
+            return this->parse<detail::elf_layout_32>();
+        }
+        return false;
+    }
+
+    template<typename Layout>
+    bool elf_image::parse() {
+        typename Layout::ehdr ehdr{};
+        if (!detail::read_at(this->file, 0, ehdr)) {
+            return false;
+        }
+        this->fileType = static_cast<elf_type>(ehdr.type);
+        this->machineType = ehdr.machine;
+
+        // Counts which don't fit in the header are in the first section header, which core files with many mappings
+        // are written with
+        typename Layout::shdr first{};
+        const bool hasSections = ehdr.shoff && ehdr.shentsize >= sizeof(first) && detail::read_at(this->file, ehdr.shoff, first);
+        std::uint64_t phnum = ehdr.phnum;
+        std::uint64_t shnum = ehdr.shnum;
+        std::uint64_t shstrndx = ehdr.shstrndx;
+        if (hasSections) {
+            if (phnum == detail::elf_pn_xnum) phnum = first.info;
+            if (shnum == 0) shnum = first.size;
+            if (shstrndx == detail::elf_shn_xindex) shstrndx = first.link;
+        } else {
+            shnum = 0;
+        }
+
+        if (phnum && ehdr.phentsize >= sizeof(typename Layout::phdr)) {
+            for (std::uint64_t i = 0; i < phnum; i++) {
+                typename Layout::phdr phdr{};
+                if (!detail::read_at(this->file, static_cast<std::size_t>(ehdr.phoff + i * ehdr.phentsize), phdr)) {
+                    return false;
+                }
+                if (phdr.type != detail::elf_pt_load) {
+                    continue;
+                }
+
+                hat::protection prot{};
+                if (phdr.flags & 4) prot |= hat::protection::Read;
+                if (phdr.flags & 2) prot |= hat::protection::Write;
+                if (phdr.flags & 1) prot |= hat::protection::Execute;
+
+                this->segmentTable.push_back({
+                    .virtual_address = phdr.vaddr,
+                    .memory_size = phdr.memsz,
+                    .data = detail::clip(this->file, phdr.offset, std::min<std::uint64_t>(phdr.filesz, phdr.memsz)),
+                    .protection = prot,
+                });
+            }
+        }
+
+        typename Layout::shdr strtab{};
+        if (shnum == 0 || shstrndx >= shnum
+            || !detail::read_at(this->file, static_cast<std::size_t>(ehdr.shoff + shstrndx * ehdr.shentsize), strtab)) {
+            return true;
+        }
+        const auto strings = detail::clip(this->file, strtab.offset, strtab.size);
+
+        this->sectionTable.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(shnum, this->file.size() / sizeof(first))));
+        for (std::uint64_t i = 1; i < shnum; i++) {
+            typename Layout::shdr shdr{};
+            if (!detail::read_at(this->file, static_cast<std::size_t>(ehdr.shoff + i * ehdr.shentsize), shdr)) {
+                // A truncated section table doesn't make the segments unusable, which is all core files need
+                this->sectionTable.clear();
+                return true;
+            }
+
+            std::string_view name{};
+            if (shdr.name < strings.size()) {
+                const auto* const begin = reinterpret_cast<const char*>(strings.data() + shdr.name);
+                name = {begin, strnlen(begin, strings.size() - shdr.name)};
+            }
+
+            // Sections are readable if they're loaded at all, the same as process::module
+            hat::protection prot = hat::protection::Read;
+            if (shdr.flags & 1) prot |= hat::protection::Write;
+            if (shdr.flags & 4) prot |= hat::protection::Execute;
+
+            this->sectionTable.push_back({
+                .name = name,
+                .virtual_address = (shdr.flags & 2) ? shdr.addr : 0,
+                .data = shdr.type != detail::elf_sht_nobits ? detail::clip(this->file, shdr.offset, shdr.size) : std::span<const std::byte>{},
+                .protection = prot,
+            });
+        }
+        return true;
+    }
+
+    std::span<const std::byte> elf_image::get_section_data(const std::string_view name) const {
+        const auto it = std::ranges::find(this->sectionTable, name, &elf_section::name);
+        return it != this->sectionTable.end() ? it->data : std::span<const std::byte>{};
+    }
+
+    void elf_image::for_each_section(const std::function<bool(std::string_view, std::span<const std::byte>, hat::protection)>& callback) const {
+        for (const auto& section : this->sectionTable) {
+            if (!callback(section.name, section.data, section.protection)) {
+                break;
+            }
+        }
+    }
+
+    void elf_image::for_each_segment(const std::function<bool(std::span<const std::byte>, hat::protection)>& callback) const {
+        for (const auto& segment : this->segmentTable) {
+            if (!callback(segment.data, segment.protection)) {
+                break;
+            }
+        }
+    }
+
+    std::optional<std::size_t> elf_image::address_to_offset(const std::uint64_t address) const noexcept {
+        for (const auto& segment : this->segmentTable) {
+            if (address >= segment.virtual_address && address - segment.virtual_address < segment.data.size()) {
+                return static_cast<std::size_t>(segment.data.data() - this->file.data()) + static_cast<std::size_t>(address - segment.virtual_address);
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::uint64_t> elf_image::offset_to_address(const std::size_t offset) const noexcept {
+        for (const auto& segment : this->segmentTable) {
+            if (segment.data.empty()) {
+                continue;
+            }
+            const auto begin = static_cast<std::size_t>(segment.data.data() - this->file.data());
+            if (offset >= begin && offset - begin < segment.data.size()) {
+                return segment.virtual_address + (offset - begin);
+            }
+        }
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,118 @@
+#include <libhat/hash.hpp>
+#include <libhat/process.hpp>
+#include <libhat/system.hpp>
+
+#include "Hash.hpp"
+
+#include <array>
+#include <bit>
+
+namespace hat::detail {
+
+    static constexpr std::uint32_t crc32c_polynomial = 0x82F63B78; // Reflected
+
+    static constexpr auto crc32c_table = [] {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < table.size(); i++) {
+            auto crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (crc & 1 ? crc32c_polynomial : 0);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    static std::uint32_t crc32c_single(std::uint32_t crc, const std::byte* data, const std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            crc = crc32c_table[(crc ^ std::to_integer<std::uint32_t>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    // A CRC state advanced over zero bytes is a linear function of the state, so it can be represented as a 32x32
+    // matrix over GF(2), stored as one column per bit
+    using gf2_matrix = std::array<std::uint32_t, 32>;
+
+    static std::uint32_t gf2_multiply(const gf2_matrix& matrix, std::uint32_t vector) {
+        std::uint32_t result{};
+        for (std::size_t i = 0; vector; i++, vector >>= 1) {
+            if (vector & 1) {
+                result ^= matrix[i];
+            }
+        }
+        return result;
+    }
+
+    static gf2_matrix gf2_square(const gf2_matrix& matrix) {
+        gf2_matrix result{};
+        for (std::size_t i = 0; i < result.size(); i++) {
+            result[i] = gf2_multiply(matrix, matrix[i]);
+        }
+        return result;
+    }
+
+    /// Lookup tables for advancing a state over crc32c_stream_size zero bytes, one per byte of the state
+    static const auto& get_crc32c_shift_tables() {
+        static const auto tables = [] {
+            // The operator for a single zero bit, squared until it covers the whole stream
+            gf2_matrix matrix{};
+            matrix[0] = crc32c_polynomial;
+            for (std::size_t i = 1; i < matrix.size(); i++) {
+                matrix[i] = std::uint32_t{1} << (i - 1);
+            }
+            for (std::size_t bits = 1; bits < crc32c_stream_size * 8; bits *= 2) {
+                matrix = gf2_square(matrix);
+            }
+
+            std::array<std::array<std::uint32_t, 256>, 4> result{};
+            for (std::size_t i = 0; i < result.size(); i++) {
+                for (std::uint32_t b = 0; b < 256; b++) {
+                    result[i][b] = gf2_multiply(matrix, b << (i * 8));
+                }
+            }
+            return result;
+        }();
+        return tables;
+    }
+
+    static_assert(std::has_single_bit(crc32c_stream_size));
+
+    std::uint32_t crc32c_shift(const std::uint32_t crc) {
+        const auto& tables = get_crc32c_shift_tables();
+        return tables[0][crc & 0xFF] ^ tables[1][(crc >> 8) & 0xFF]
+            ^ tables[2][(crc >> 16) & 0xFF] ^ tables[3][crc >> 24];
+    }
+
+    using crc32c_function_t = std::uint32_t(*)(std::uint32_t, const std::byte*, std::size_t);
+
+    static crc32c_function_t resolve_crc32c() {
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        if (compiled_extensions.sse42 || get_system().extensions.sse42) {
+            return &crc32c_sse42;
+        }
+#elif defined(LIBHAT_CRC32C_ARM)
+        return &crc32c_arm;
+#endif
+        return &crc32c_single;
+    }
+}
+
+namespace hat {
+
+    std::uint32_t crc32c(const std::span<const std::byte> data, const std::uint32_t crc) {
+        static const auto function = detail::resolve_crc32c();
+        return ~function(~crc, data.data(), data.size());
+    }
+}
+
+namespace hat::process {
+
+    std::optional<std::uint32_t> module::content_hash(const std::string_view section) const {
+        const auto data = this->get_section_data(section);
+        if (data.empty()) {
+            return std::nullopt;
+        }
+        return crc32c(data);
+    }
+}
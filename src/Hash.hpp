@@ -0,0 +1,24 @@
+#pragma once
+
+#include <libhat/defines.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// The ARMv8 CRC32 instructions are optional before ARMv8.1, so they're only used when the target guarantees them
+#if defined(LIBHAT_AARCH64) && (defined(__ARM_FEATURE_CRC32) || defined(_MSC_VER))
+    #define LIBHAT_CRC32C_ARM
+#endif
+
+namespace hat::detail {
+
+    /// The number of bytes in each of the three interleaved streams of the hardware CRC32C implementations
+    inline constexpr std::size_t crc32c_stream_size = 8192;
+
+    /// Advances a raw CRC32C state over crc32c_stream_size zero bytes, used to join the interleaved streams
+    [[nodiscard]] std::uint32_t crc32c_shift(std::uint32_t crc);
+
+    // Update a raw CRC32C state, without the inversion of the initial and final value
+    [[nodiscard]] std::uint32_t crc32c_sse42(std::uint32_t crc, const std::byte* data, std::size_t size);
+    [[nodiscard]] std::uint32_t crc32c_arm(std::uint32_t crc, const std::byte* data, std::size_t size);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace hat::detail {
+
+    /// A read-only view of a file mapped into memory. Empty if the file couldn't be opened or mapped.
+    class mapped_file {
+    public:
+        mapped_file() = default;
+        explicit mapped_file(const std::filesystem::path& path);
+        ~mapped_file();
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+        mapped_file& operator=(mapped_file&& other) noexcept {
+            std::swap(this->data_, other.data_);
+            std::swap(this->size_, other.size_);
+            return *this;
+        }
+
+        [[nodiscard]] std::span<const std::byte> data() const {
+            return {this->data_, this->size_};
+        }
+
+    private:
+        const std::byte* data_{};
+        std::size_t size_{};
+    };
+}
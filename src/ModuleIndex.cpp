@@ -0,0 +1,136 @@
+#include <libhat/module_index.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace hat::detail {
+
+    static constexpr std::size_t index_sequence_size = 4;
+    static constexpr std::size_t max_index_stride = 32;
+    static constexpr int min_index_bits = 8;
+    static constexpr int max_index_bits = 30;
+
+    static std::uint32_t load_sequence(const std::byte* data) {
+        std::uint32_t sequence;
+        std::memcpy(&sequence, data, sizeof(sequence));
+        return sequence;
+    }
+
+    static std::uint32_t hash_sequence(const std::uint32_t sequence, const int bits) {
+        return (sequence * 0x9E3779B1u) >> (32 - bits);
+    }
+
+    static std::size_t count_indexed(const std::size_t size, const std::size_t stride) {
+        return size < index_sequence_size ? 0 : (size - index_sequence_size) / stride + 1;
+    }
+
+    /// One to two positions per bucket
+    static int get_index_bits(const std::size_t count) {
+        return std::clamp(static_cast<int>(std::bit_width(count)) - 1, min_index_bits, max_index_bits);
+    }
+
+    static std::size_t get_index_size(const std::size_t size, const std::size_t stride) {
+        const auto count = count_indexed(size, stride);
+        return (count + (std::size_t{1} << get_index_bits(count)) + 1) * sizeof(std::uint32_t);
+    }
+}
+
+namespace hat {
+
+    module_index::module_index(const std::span<const std::byte> data, const module_index_options& options) : bytes(data) {
+        if (data.size() < detail::index_sequence_size || data.size() > std::numeric_limits<std::uint32_t>::max()) {
+            return;
+        }
+
+        for (std::size_t stride = 1; stride <= detail::max_index_stride; stride++) {
+            if (!options.memory_budget || detail::get_index_size(data.size(), stride) <= options.memory_budget) {
+                this->step = stride;
+                break;
+            }
+        }
+        if (!this->step) {
+            return;
+        }
+
+        const auto count = detail::count_indexed(data.size(), this->step);
+        this->bits = detail::get_index_bits(count);
+        this->buckets.resize((std::size_t{1} << this->bits) + 1);
+        this->positions.resize(count);
+
+        // Counting sort by bucket, visiting the positions in ascending order
+        for (std::size_t i = 0; i < count; i++) {
+            const auto sequence = detail::load_sequence(data.data() + i * this->step);
+            this->buckets[detail::hash_sequence(sequence, this->bits) + 1]++;
+        }
+        for (std::size_t i = 1; i < this->buckets.size(); i++) {
+            this->buckets[i] += this->buckets[i - 1];
+        }
+        std::vector<std::uint32_t> cursors(this->buckets.begin(), this->buckets.end() - 1);
+        for (std::size_t i = 0; i < count; i++) {
+            const auto position = i * this->step;
+            const auto sequence = detail::load_sequence(data.data() + position);
+            this->positions[cursors[detail::hash_sequence(sequence, this->bits)]++] = static_cast<std::uint32_t>(position);
+        }
+    }
+
+    module_index::module_index(const process::module& mod, const std::string_view section, const module_index_options& options)
+        : module_index(mod.get_section_data(section), options) {}
+
+    std::span<const std::uint32_t> module_index::lookup(const std::uint32_t sequence) const noexcept {
+        const auto bucket = detail::hash_sequence(sequence, this->bits);
+        return std::span{this->positions}.subspan(this->buckets[bucket], this->buckets[bucket + 1] - this->buckets[bucket]);
+    }
+
+    const_scan_result module_index::find_pattern(const signature_view signature, const scan_alignment alignment) const {
+        const auto [runOffset, runSize] = detail::find_longest_exact_run(signature);
+        if (!this->step || runSize < detail::index_sequence_size + this->step - 1) {
+            return hat::find_pattern(this->bytes.begin(), this->bytes.end(), signature, alignment);
+        }
+
+        std::array<std::byte, detail::index_sequence_size> sequenceBytes{};
+        const auto sequence_at = [&](const std::size_t offset) {
+            for (std::size_t i = 0; i < sequenceBytes.size(); i++) {
+                sequenceBytes[i] = signature[runOffset + offset + i].value();
+            }
+            return detail::load_sequence(sequenceBytes.data());
+        };
+
+        // A match starting at any position has the sequences at every Nth offset of the run at indexed positions, for
+        // one of the N residues of the offset. For each residue, only the sequence with the fewest positions is used.
+        const auto sequences = runSize - detail::index_sequence_size + 1;
+        const auto stride = detail::to_stride(alignment);
+        std::size_t best = this->bytes.size();
+        for (std::size_t residue = 0; residue < this->step; residue++) {
+            std::size_t offset{};
+            std::span<const std::uint32_t> candidates{};
+            for (auto i = residue; i < sequences; i += this->step) {
+                const auto positions = this->lookup(sequence_at(i));
+                if (i == residue || positions.size() < candidates.size()) {
+                    offset = runOffset + i;
+                    candidates = positions;
+                }
+            }
+
+            // The positions are ascending, so the first match is the lowest one
+            for (const auto position : candidates) {
+                if (position < offset) {
+                    continue;
+                }
+                const auto start = position - offset;
+                if (start >= best || signature.size() > this->bytes.size() - start) {
+                    break;
+                }
+                const auto* const match = this->bytes.data() + start;
+                if (reinterpret_cast<std::uintptr_t>(match) % stride == 0
+                    && std::equal(signature.begin(), signature.end(), match)) {
+                    best = start;
+                    break;
+                }
+            }
+        }
+        return best != this->bytes.size() ? this->bytes.data() + best : nullptr;
+    }
+}
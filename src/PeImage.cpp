@@ -0,0 +1,177 @@
+#include <libhat/pe_image.hpp>
+
+#include "MappedFile.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hat::detail {
+
+    static constexpr std::uint16_t pe_optional_magic_32 = 0x10B;
+    static constexpr std::uint16_t pe_optional_magic_64 = 0x20B;
+
+    static constexpr std::uint32_t pe_section_execute = 0x20000000;
+    static constexpr std::uint32_t pe_section_read    = 0x40000000;
+    static constexpr std::uint32_t pe_section_write   = 0x80000000;
+
+    // The layouts of IMAGE_FILE_HEADER and IMAGE_SECTION_HEADER, which aren't available outside of Windows. The fields
+    // are little endian, which is assumed to be the byte order of the host.
+    struct pe_file_header {
+        std::uint16_t machine;
+        std::uint16_t numberOfSections;
+        std::uint32_t timeDateStamp;
+        std::uint32_t pointerToSymbolTable;
+        std::uint32_t numberOfSymbols;
+        std::uint16_t sizeOfOptionalHeader;
+        std::uint16_t characteristics;
+    };
+
+    struct pe_section_header {
+        char name[8];
+        std::uint32_t virtualSize;
+        std::uint32_t virtualAddress;
+        std::uint32_t sizeOfRawData;
+        std::uint32_t pointerToRawData;
+        std::uint32_t pointerToRelocations;
+        std::uint32_t pointerToLinenumbers;
+        std::uint16_t numberOfRelocations;
+        std::uint16_t numberOfLinenumbers;
+        std::uint32_t characteristics;
+    };
+
+    static_assert(sizeof(pe_file_header) == 20 && sizeof(pe_section_header) == 40);
+}
+
+namespace hat {
+
+    std::optional<pe_image> pe_image::open(const std::filesystem::path& path) {
+        auto file = std::make_shared<detail::mapped_file>(path);
+        const auto data = file->data();
+        if (pe_image image{std::move(file), data}; image.parse()) {
+            return image;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<pe_image> pe_image::from_bytes(const std::span<const std::byte> data) {
+        if (pe_image image{nullptr, data}; image.parse()) {
+            return image;
+        }
+        return std::nullopt;
+    }
+
+    bool pe_image::parse() {
+        std::uint16_t dosMagic{};
+        std::uint32_t lfanew{};
+        if (!detail::read_at(this->file, 0, dosMagic) || dosMagic != 0x5A4D || !detail::read_at(this->file, 0x3C, lfanew)) {
+            return false;
+        }
+
+        std::uint32_t ntSignature{};
+        detail::pe_file_header fileHeader{};
+        std::uint16_t optionalMagic{};
+        const std::size_t optionalHeader = std::size_t{lfanew} + sizeof(ntSignature) + sizeof(fileHeader);
+        if (!detail::read_at(this->file, lfanew, ntSignature) || ntSignature != 0x4550
+            || !detail::read_at(this->file, lfanew + sizeof(ntSignature), fileHeader)
+            || !detail::read_at(this->file, optionalHeader, optionalMagic)) {
+            return false;
+        }
+
+        if (optionalMagic == detail::pe_optional_magic_64) {
+            this->pe32Plus = true;
+            if (!detail::read_at(this->file, optionalHeader + 24, this->imageBase)) {
+                return false;
+            }
+        } else if (optionalMagic == detail::pe_optional_magic_32) {
+            std::uint32_t imageBase32{};
+            if (!detail::read_at(this->file, optionalHeader + 28, imageBase32)) {
+                return false;
+            }
+            this->imageBase = imageBase32;
+        } else {
+            return false;
+        }
+        if (!detail::read_at(this->file, optionalHeader + 60, this->sizeOfHeaders)) {
+            return false;
+        }
+
+        const auto sectionHeaders = optionalHeader + fileHeader.sizeOfOptionalHeader;
+        this->sectionTable.reserve(fileHeader.numberOfSections);
+        for (std::size_t i = 0; i < fileHeader.numberOfSections; i++) {
+            detail::pe_section_header header{};
+            if (!detail::read_at(this->file, sectionHeaders + i * sizeof(header), header)) {
+                return false;
+            }
+
+            // Sections with uninitialized data at their end are shorter in the file, and the raw data is padded to
+            // the file alignment otherwise. Truncated files are read as far as they go.
+            std::size_t rawSize = header.sizeOfRawData;
+            if (header.virtualSize) {
+                rawSize = std::min<std::size_t>(rawSize, header.virtualSize);
+            }
+            const std::size_t rawOffset = std::min<std::size_t>(header.pointerToRawData, this->file.size());
+            rawSize = std::min(rawSize, this->file.size() - rawOffset);
+
+            // The name is padded with NULs, but only terminated if it's shorter than the field
+            const auto* const name = this->file.data() + sectionHeaders + i * sizeof(header);
+            const auto nameSize = static_cast<std::size_t>(std::ranges::find(name, name + sizeof(header.name), std::byte{}) - name);
+
+            hat::protection prot{};
+            if (header.characteristics & detail::pe_section_read) prot |= hat::protection::Read;
+            if (header.characteristics & detail::pe_section_write) prot |= hat::protection::Write;
+            if (header.characteristics & detail::pe_section_execute) prot |= hat::protection::Execute;
+
+            this->sectionTable.push_back({
+                .name = {reinterpret_cast<const char*>(name), nameSize},
+                .virtual_address = header.virtualAddress,
+                .virtual_size = header.virtualSize ? header.virtualSize : header.sizeOfRawData,
+                .data = rawSize ? this->file.subspan(rawOffset, rawSize) : std::span<const std::byte>{},
+                .protection = prot,
+            });
+        }
+        return true;
+    }
+
+    std::span<const std::byte> pe_image::get_section_data(const std::string_view name) const {
+        const auto it = std::ranges::find(this->sectionTable, name, &pe_section::name);
+        return it != this->sectionTable.end() ? it->data : std::span<const std::byte>{};
+    }
+
+    void pe_image::for_each_section(const std::function<bool(std::string_view, std::span<const std::byte>, hat::protection)>& callback) const {
+        for (const auto& section : this->sectionTable) {
+            if (!callback(section.name, section.data, section.protection)) {
+                break;
+            }
+        }
+    }
+
+    std::optional<std::size_t> pe_image::rva_to_offset(const std::uint32_t rva) const noexcept {
+        // The headers are mapped as they are in the file
+        if (rva < this->sizeOfHeaders) {
+            return rva < this->file.size() ? std::optional<std::size_t>{rva} : std::nullopt;
+        }
+        for (const auto& section : this->sectionTable) {
+            if (rva >= section.virtual_address && rva - section.virtual_address < section.data.size()) {
+                return static_cast<std::size_t>(section.data.data() - this->file.data()) + (rva - section.virtual_address);
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::uint32_t> pe_image::offset_to_rva(const std::size_t offset) const noexcept {
+        if (offset < this->sizeOfHeaders && offset < this->file.size()) {
+            return static_cast<std::uint32_t>(offset);
+        }
+        for (const auto& section : this->sectionTable) {
+            if (section.data.empty()) {
+                continue;
+            }
+            const auto begin = static_cast<std::size_t>(section.data.data() - this->file.data());
+            if (offset >= begin && offset - begin < section.data.size()) {
+                return section.virtual_address + static_cast<std::uint32_t>(offset - begin);
+            }
+        }
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,119 @@
+#include <libhat/pointers.hpp>
+#include <libhat/system.hpp>
+
+#include "Pointers.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace hat::detail {
+
+    using pointer_range_function_t = std::size_t(*)(const std::byte*, std::size_t, pointer_range_filter, std::vector<std::size_t>&);
+    using pointer_values_function_t = std::size_t(*)(const std::byte*, std::size_t, const pointer_values_filter&, std::vector<std::size_t>&);
+
+    struct pointer_kernels {
+        pointer_range_function_t range{};
+        pointer_values_function_t values{};
+    };
+
+    static pointer_kernels resolve_pointer_kernels() {
+        [[maybe_unused]] const auto& ext = get_system().extensions;
+#if defined(LIBHAT_X86_64) && defined(LIBHAT_FEATURE_AVX512)
+        if (compiled_extensions.avx512f || ext.avx512f) {
+            return {&find_pointers_range_avx512, &find_pointers_values_avx512};
+        }
+#endif
+#if defined(LIBHAT_X86_64)
+        if (compiled_extensions.avx2 || ext.avx2) {
+            return {&find_pointers_range_avx2, &find_pointers_values_avx2};
+        }
+#endif
+#if defined(LIBHAT_AARCH64)
+        if (compiled_extensions.neon || ext.neon) {
+            return {&find_pointers_range_neon, &find_pointers_values_neon};
+        }
+#endif
+        return {};
+    }
+
+    /// Finds the pointer aligned values within [low, high] for which "matches" returns true. "exact" is the set of values
+    /// which can match, if there is one. Small sets are compared exactly instead of against the range, a single value
+    /// already being its own range.
+    template<typename Matches>
+    static std::vector<const_scan_result> find_pointers(
+        const std::span<const std::byte>      data,
+        const std::uintptr_t                  low,
+        const std::uintptr_t                  high,
+        const std::span<const std::uintptr_t> exact,
+        Matches&&                             matches
+    ) {
+        const auto address = reinterpret_cast<std::uintptr_t>(data.data());
+        const auto skip = std::min(static_cast<std::size_t>(fast_align_up(address, sizeof(std::uintptr_t)) - address), data.size());
+        const auto* const words = data.data() + skip;
+        const auto count = (data.size() - skip) / sizeof(std::uintptr_t);
+
+        std::vector<std::size_t> candidates{};
+        std::size_t i = 0;
+        static const auto kernels = resolve_pointer_kernels();
+        if (exact.size() > 1 && exact.size() <= pointer_filter_values && kernels.values) {
+            pointer_values_filter values{};
+            std::ranges::fill(values, exact.front());
+            std::ranges::copy(exact, values.begin());
+            i = kernels.values(words, count, values, candidates);
+        } else if (kernels.range) {
+            i = kernels.range(words, count, {low, high - low}, candidates);
+        }
+        for (; i < count; i++) {
+            std::uintptr_t value;
+            std::memcpy(&value, words + i * sizeof(value), sizeof(value));
+            if (value - low <= high - low) {
+                candidates.push_back(i);
+            }
+        }
+
+        std::vector<const_scan_result> results{};
+        for (const auto index : candidates) {
+            std::uintptr_t value;
+            std::memcpy(&value, words + index * sizeof(value), sizeof(value));
+            if (matches(value)) {
+                results.emplace_back(words + index * sizeof(value));
+            }
+        }
+        return results;
+    }
+}
+
+namespace hat {
+
+    std::vector<const_scan_result> find_pointers(const std::span<const std::byte> data, const std::uintptr_t value) {
+        return detail::find_pointers(data, value, value, {}, [](std::uintptr_t) { return true; });
+    }
+
+    std::vector<const_scan_result> find_pointers(const std::span<const std::byte> data, const std::span<const std::uintptr_t> values) {
+        if (values.empty()) {
+            return {};
+        }
+        return detail::find_pointers(data, values.front(), values.back(), values, [&](const std::uintptr_t value) {
+            return std::ranges::binary_search(values, value);
+        });
+    }
+
+    std::vector<const_scan_result> find_pointers(const std::span<const std::byte> data, const address_range range) {
+        return find_pointers(data, std::span{&range, 1});
+    }
+
+    std::vector<const_scan_result> find_pointers(const std::span<const std::byte> data, const std::span<const address_range> ranges) {
+        if (ranges.empty() || ranges.front().begin >= ranges.back().end) {
+            return {};
+        }
+        if (ranges.size() == 1) {
+            return detail::find_pointers(data, ranges.front().begin, ranges.front().end - 1, {}, [](std::uintptr_t) { return true; });
+        }
+        return detail::find_pointers(data, ranges.front().begin, ranges.back().end - 1, {}, [&](const std::uintptr_t value) {
+            const auto next = std::ranges::upper_bound(ranges, value, {}, &address_range::begin);
+            return next != ranges.begin() && std::prev(next)->contains(value);
+        });
+    }
+}
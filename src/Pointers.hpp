@@ -0,0 +1,39 @@
+#pragma once
+
+#include <libhat/defines.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hat::detail {
+
+    /// The number of values which are compared exactly, lane by lane
+    inline constexpr std::size_t pointer_filter_values = 4;
+
+    /// The values within [low, low + span], compared as unsigned integers
+    struct pointer_range_filter {
+        std::uint64_t low{};
+        std::uint64_t span{};
+    };
+
+    using pointer_values_filter = std::array<std::uint64_t, pointer_filter_values>;
+
+    // Append the indices of the candidate words in [0, count) to "out", a vector at a time, and return the index they
+    // stopped at. "words" is aligned to 8 bytes.
+#if defined(LIBHAT_X86_64)
+    std::size_t find_pointers_range_avx2(const std::byte* words, std::size_t count, pointer_range_filter filter, std::vector<std::size_t>& out);
+    std::size_t find_pointers_values_avx2(const std::byte* words, std::size_t count, const pointer_values_filter& values, std::vector<std::size_t>& out);
+#endif
+
+#if defined(LIBHAT_X86_64) && defined(LIBHAT_FEATURE_AVX512)
+    std::size_t find_pointers_range_avx512(const std::byte* words, std::size_t count, pointer_range_filter filter, std::vector<std::size_t>& out);
+    std::size_t find_pointers_values_avx512(const std::byte* words, std::size_t count, const pointer_values_filter& values, std::vector<std::size_t>& out);
+#endif
+
+#if defined(LIBHAT_AARCH64)
+    std::size_t find_pointers_range_neon(const std::byte* words, std::size_t count, pointer_range_filter filter, std::vector<std::size_t>& out);
+    std::size_t find_pointers_values_neon(const std::byte* words, std::size_t count, const pointer_values_filter& values, std::vector<std::size_t>& out);
+#endif
+}
@@ -0,0 +1,71 @@
+#include <libhat/registry.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace hat::detail {
+
+    struct address_registry {
+        std::mutex mutex{};
+        std::vector<registered_address*> entries{};
+    };
+
+    // Entries are registered during static initialization, so the registry must be initialized on first use
+    static address_registry& get_registry() {
+        static address_registry registry{};
+        return registry;
+    }
+
+    registered_address::registered_address(const scan_request request, std::byte*(*transform)(scan_result))
+        : request(request), transform(transform) {
+        auto& registry = get_registry();
+        std::scoped_lock lock{registry.mutex};
+        registry.entries.push_back(this);
+    }
+
+    void registered_address::resolve() {
+        static_cast<void>(resolve_registered());
+    }
+
+    static registry_stats resolve_pending(scan_cache* cache, const batch_options& options) {
+        auto& registry = get_registry();
+        std::scoped_lock lock{registry.mutex};
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<registered_address*> pending{};
+        std::vector<scan_request> requests{};
+        for (const auto entry : registry.entries) {
+            if (!entry->resolved.load(std::memory_order_relaxed)) {
+                pending.push_back(entry);
+                requests.push_back(entry->request);
+            }
+        }
+        if (pending.empty()) {
+            return {};
+        }
+
+        const auto results = cache
+            ? cache->resolve_all(requests, options)
+            : hat::resolve_all(requests, process::get_process_module(), options);
+
+        registry_stats stats{.resolved = pending.size()};
+        for (std::size_t i = 0; i < pending.size(); i++) {
+            pending[i]->address = pending[i]->transform(results[i]);
+            pending[i]->resolved.store(true, std::memory_order_release);
+            stats.missing += !results[i].has_result();
+        }
+        stats.elapsed = std::chrono::steady_clock::now() - start;
+        return stats;
+    }
+}
+
+namespace hat {
+
+    registry_stats resolve_registered(const batch_options& options) {
+        return detail::resolve_pending(nullptr, options);
+    }
+
+    registry_stats resolve_registered(scan_cache& cache, const batch_options& options) {
+        return detail::resolve_pending(&cache, options);
+    }
+}
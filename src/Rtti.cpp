@@ -0,0 +1,262 @@
+#include <libhat/rtti.hpp>
+#include <libhat/pointers.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+namespace hat::detail {
+
+    // ELF modules with and without position independent code, and PE modules built by MinGW
+    static constexpr std::array<std::string_view, 3> rtti_sections{".rodata", ".data.rel.ro", ".rdata"};
+
+    static constexpr std::size_t max_type_name_size = 4096;
+
+    static std::uintptr_t load_pointer(const std::uintptr_t address) {
+        std::uintptr_t value;
+        std::memcpy(&value, reinterpret_cast<const void*>(address), sizeof(value));
+        return value;
+    }
+
+    static bool is_type_name_char(const char ch) {
+        return (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || ch == '_' || ch == '$' || ch == '.';
+    }
+
+    /// Reads the mangled class name at "address", which starts with the length of an unqualified name, or a nested
+    /// (N), standard (S) or local (Z) name. GCC prefixes the names of classes with internal linkage with a '*', which
+    /// is stripped like std::type_info::name does.
+    static std::optional<std::string_view> read_type_name(const std::span<const std::byte> section, const std::uintptr_t address) {
+        const auto offset = address - reinterpret_cast<std::uintptr_t>(section.data());
+        const auto size = std::min(section.size() - offset, max_type_name_size);
+        const auto* const begin = reinterpret_cast<const char*>(section.data() + offset);
+        const auto* const end = static_cast<const char*>(std::memchr(begin, '\0', size));
+        if (!end || end - begin < 2) {
+            return std::nullopt;
+        }
+
+        std::string_view name{begin, end};
+        if (name.front() == '*') {
+            name.remove_prefix(1);
+            if (name.size() < 2) {
+                return std::nullopt;
+            }
+        }
+        const auto first = name.front();
+        if (!(first >= '1' && first <= '9') && first != 'N' && first != 'S' && first != 'Z') {
+            return std::nullopt;
+        }
+        if (!std::ranges::all_of(name, is_type_name_char)) {
+            return std::nullopt;
+        }
+        return name;
+    }
+
+    // The x64 layout of RTTICompleteObjectLocator, which refers to everything by its address relative to the image
+    struct msvc_complete_object_locator {
+        std::uint32_t signature;
+        std::uint32_t offset;
+        std::uint32_t cdOffset;
+        std::uint32_t typeDescriptor;
+        std::uint32_t classDescriptor;
+        std::uint32_t self;
+    };
+
+    static constexpr std::uint32_t msvc_locator_signature_64 = 1;
+
+    /// Reads the decorated class name at "offset", which is terminated by "@@"
+    static std::optional<std::string_view> read_decorated_name(const std::span<const std::byte> section, const std::size_t offset) {
+        const auto size = std::min(section.size() - offset, max_type_name_size);
+        const auto* const begin = reinterpret_cast<const char*>(section.data() + offset);
+        const auto* const end = static_cast<const char*>(std::memchr(begin, '\0', size));
+        if (!end) {
+            return std::nullopt;
+        }
+        const std::string_view name{begin, end};
+        if (name.size() < 7 || (name[3] != 'V' && name[3] != 'U') || !name.ends_with("@@")) {
+            return std::nullopt;
+        }
+        return name;
+    }
+}
+
+namespace hat {
+
+    rtti_index::rtti_index(const process::module& mod) {
+        std::vector<std::span<const std::byte>> sections{};
+        for (const auto name : detail::rtti_sections) {
+            if (const auto data = mod.get_section_data(name); !data.empty()) {
+                sections.emplace_back(data);
+            }
+        }
+        std::ranges::sort(sections, {}, [](const auto& section) { return section.data(); });
+
+        std::vector<address_range> ranges{};
+        for (const auto& section : sections) {
+            ranges.push_back(to_address_range(section));
+        }
+        const auto section_of = [&](const std::uintptr_t address) -> std::span<const std::byte> {
+            const auto next = std::ranges::upper_bound(ranges, address, {}, &address_range::begin);
+            if (next == ranges.begin() || !std::prev(next)->contains(address)) {
+                return {};
+            }
+            return sections[static_cast<std::size_t>(std::distance(ranges.begin(), next)) - 1];
+        };
+        const auto preceding = [&](const std::uintptr_t location) -> std::optional<std::uintptr_t> {
+            const auto section = section_of(location);
+            if (location - reinterpret_cast<std::uintptr_t>(section.data()) < sizeof(std::uintptr_t)) {
+                return std::nullopt;
+            }
+            return detail::load_pointer(location - sizeof(std::uintptr_t));
+        };
+
+        // The single pass over the sections, the locations of all pointers into them in ascending order
+        std::vector<std::uintptr_t> locations{};
+        for (const auto& section : sections) {
+            for (const auto result : find_pointers(section, ranges)) {
+                locations.push_back(reinterpret_cast<std::uintptr_t>(result.get()));
+            }
+        }
+
+        // A type_info is a pointer to the vtable of its std::type_info subclass, followed by a pointer to its name
+        std::unordered_map<std::uintptr_t, rtti_entry*> typeInfos{};
+        for (const auto location : locations) {
+            const auto value = detail::load_pointer(location);
+            const auto name = detail::read_type_name(section_of(value), value);
+            if (!name) {
+                continue;
+            }
+            const auto vptr = preceding(location);
+            if (!vptr || !*vptr) {
+                continue;
+            }
+            const auto typeInfo = location - sizeof(std::uintptr_t);
+            const auto [it, inserted] = this->entries.try_emplace(*name, rtti_entry{reinterpret_cast<std::byte*>(typeInfo)});
+            if (inserted) {
+                typeInfos.emplace(typeInfo, &it->second);
+            }
+        }
+
+        // The primary vtable of a class starts with an offset to the top of the object of 0, followed by a pointer to
+        // its type_info, and objects point past them. Pointers to a type_info in other type_info objects are preceded
+        // by a name, flags or the offset of a base class, which are never 0.
+        for (const auto location : locations) {
+            const auto it = typeInfos.find(detail::load_pointer(location));
+            if (it == typeInfos.end() || it->second->vtable) {
+                continue;
+            }
+            if (const auto offsetToTop = preceding(location); offsetToTop && *offsetToTop == 0) {
+                it->second->vtable = reinterpret_cast<std::byte*>(location + sizeof(std::uintptr_t));
+            }
+        }
+    }
+
+    std::optional<rtti_entry> rtti_index::find(const std::string_view mangledName) const {
+        if (const auto it = this->entries.find(mangledName); it != this->entries.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    scan_result rtti_index::find_vtable(const std::string_view mangledName) const {
+        const auto entry = this->find(mangledName);
+        return entry ? entry->vtable : nullptr;
+    }
+}
+
+namespace hat {
+
+    msvc_rtti_index::msvc_rtti_index(const pe_image& image) : image(image) {
+        // The absolute addresses of the locators are compared as pointers of the host
+        if (!image.is_64bit() || sizeof(std::uintptr_t) < sizeof(std::uint64_t)) {
+            return;
+        }
+
+        std::vector<const pe_section*> sections{};
+        for (const auto& section : image.sections()) {
+            if (!section.data.empty() && !static_cast<bool>(section.protection & protection::Execute)) {
+                sections.push_back(&section);
+            }
+        }
+
+        // A TypeDescriptor is a pointer to the vtable of type_info and a reserved pointer, followed by the name
+        static const auto namePrefix = string_to_signature(std::string_view{".?A"}).value();
+        std::unordered_map<std::uint32_t, msvc_rtti_entry*> typeDescriptors{};
+        for (const auto* section : sections) {
+            const auto data = section->data;
+            for (const auto match : find_all_pattern(data, namePrefix)) {
+                const auto offset = static_cast<std::size_t>(match.get() - data.data());
+                const auto name = detail::read_decorated_name(data, offset);
+                if (!name || offset < 2 * sizeof(std::uint64_t)) {
+                    continue;
+                }
+                const auto typeDescriptor = offset - 2 * sizeof(std::uint64_t);
+                const auto rva = section->virtual_address + static_cast<std::uint32_t>(typeDescriptor);
+                if (rva % alignof(std::uint64_t) != 0) {
+                    continue;
+                }
+                const auto [it, inserted] = this->entries.try_emplace(*name, msvc_rtti_entry{data.data() + typeDescriptor});
+                if (inserted) {
+                    typeDescriptors.emplace(rva, &it->second);
+                }
+            }
+        }
+
+        // The locator of the primary vtable is the one at offset 0 within the complete object
+        std::unordered_map<std::uintptr_t, msvc_rtti_entry*> locators{};
+        for (const auto* section : sections) {
+            const auto data = section->data;
+            std::size_t offset = (4 - section->virtual_address % 4) % 4;
+            for (; offset + sizeof(detail::msvc_complete_object_locator) <= data.size(); offset += 4) {
+                std::uint32_t signature;
+                std::memcpy(&signature, data.data() + offset, sizeof(signature));
+                if (signature != detail::msvc_locator_signature_64) {
+                    continue;
+                }
+                detail::msvc_complete_object_locator locator{};
+                std::memcpy(&locator, data.data() + offset, sizeof(locator));
+                const auto rva = section->virtual_address + static_cast<std::uint32_t>(offset);
+                if (locator.self != rva || locator.offset != 0) {
+                    continue;
+                }
+                const auto it = typeDescriptors.find(locator.typeDescriptor);
+                if (it == typeDescriptors.end() || it->second->complete_object_locator) {
+                    continue;
+                }
+                it->second->complete_object_locator = data.data() + offset;
+                locators.emplace(static_cast<std::uintptr_t>(image.image_base() + rva), it->second);
+            }
+        }
+
+        // The absolute address of the locator precedes the vtable, and is relocated when the image is loaded
+        std::vector<std::uintptr_t> addresses{};
+        addresses.reserve(locators.size());
+        for (const auto address : locators | std::views::keys) {
+            addresses.push_back(address);
+        }
+        std::ranges::sort(addresses);
+        for (const auto* section : sections) {
+            for (const auto result : find_pointers(section->data, addresses)) {
+                std::uintptr_t address;
+                std::memcpy(&address, result.get(), sizeof(address));
+                if (auto& entry = *locators.at(address); !entry.vtable) {
+                    entry.vtable = result.get() + sizeof(address);
+                }
+            }
+        }
+    }
+
+    std::optional<msvc_rtti_entry> msvc_rtti_index::find(const std::string_view decoratedName) const {
+        if (const auto it = this->entries.find(decoratedName); it != this->entries.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    const_scan_result msvc_rtti_index::find_vtable(const std::string_view decoratedName) const {
+        const auto entry = this->find(decoratedName);
+        return entry ? entry->vtable : nullptr;
+    }
+}
@@ -0,0 +1,161 @@
+#include <libhat/scanner.hpp>
+
+#include "Utils.hpp"
+
+#include <cstring>
+
+namespace hat::detail {
+
+    static constexpr std::uint64_t swar_low_bits = 0x7F7F7F7F7F7F7F7F;
+
+    LIBHAT_FORCEINLINE static std::uint64_t load_word(const void* ptr) {
+        std::uint64_t word;
+        std::memcpy(&word, ptr, sizeof(word));
+        if constexpr (std::endian::native == std::endian::big) {
+            // The lanes are always numbered from the lowest address, matching the data's byte order
+            word = ((word & 0x00FF00FF00FF00FF) << 8) | ((word >> 8) & 0x00FF00FF00FF00FF);
+            word = ((word & 0x0000FFFF0000FFFF) << 16) | ((word >> 16) & 0x0000FFFF0000FFFF);
+            word = (word << 32) | (word >> 32);
+        }
+        return word;
+    }
+
+    LIBHAT_FORCEINLINE static constexpr std::uint64_t broadcast_byte(const std::byte value) {
+        return std::to_integer<std::uint64_t>(value) * 0x0101010101010101;
+    }
+
+    /// Sets the high bit of each byte lane where the word equals the pattern. Unlike the usual "has zero byte"
+    /// trick, no borrow propagates between lanes, so every set bit is an exact match.
+    LIBHAT_FORCEINLINE static constexpr std::uint64_t match_bytes(const std::uint64_t word, const std::uint64_t pattern) {
+        const auto diff = word ^ pattern;
+        return ~(((diff & swar_low_bits) + swar_low_bits) | diff | swar_low_bits);
+    }
+
+    /// Lanes where a candidate is aligned, for words at addresses that are a multiple of 16 and for those that aren't
+    template<scan_alignment alignment>
+    static constexpr std::array<std::uint64_t, 2> create_alignment_masks_swar(const std::size_t cmpIndex) {
+        std::array<std::uint64_t, 2> masks{};
+        for (std::size_t half = 0; half < masks.size(); half++) {
+            for (std::size_t lane = 0; lane < 8; lane++) {
+                if ((half * 8 + lane + alignment_stride<alignment> * 16 - cmpIndex) % alignment_stride<alignment> == 0) {
+                    masks[half] |= std::uint64_t{0x80} << (lane * 8);
+                }
+            }
+        }
+        return masks;
+    }
+
+    template<scan_alignment alignment, bool cmpeq2, bool veccmp>
+    static const_scan_result find_pattern_swar(const std::byte* begin, const std::byte* end, const scan_context& context) {
+        const auto signature = context.signature;
+        const auto cmpIndex = cmpeq2 ? *context.pairIndex : context.cmpIndex;
+
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "SWAR";
+            stats.anchor_index = cmpIndex;
+            stats.pair_index = cmpeq2 ? context.pairIndex : std::nullopt);
+
+        // 64 bit word containing first signature byte repeated
+        const auto firstByte = broadcast_byte(*signature[cmpIndex]);
+
+        std::uint64_t secondByte{};
+        if constexpr (cmpeq2) {
+            secondByte = broadcast_byte(*signature[cmpIndex + 1]);
+        }
+
+        std::uint64_t signatureBytes{}, signatureMask{};
+        if constexpr (veccmp) {
+            signatureBytes = load_word(context.packed.values.data());
+            signatureMask = load_word(context.packed.masks.data());
+        }
+
+        std::array<std::uint64_t, 2> alignmentMasks{};
+        if constexpr (alignment != scan_alignment::X1) {
+            alignmentMasks = create_alignment_masks_swar<alignment>(cmpIndex);
+        }
+
+        auto [pre, vec, post] = segment_scan<std::uint64_t, 8, veccmp>(begin, end, signature.size(), cmpIndex);
+
+        if (!pre.empty()) {
+            const auto result = find_pattern_single<alignment>(pre.data(), pre.data() + pre.size(), context);
+            if (result.has_result()) {
+                return result;
+            }
+        }
+
+        const auto vec_begin = std::to_address(vec.begin());
+        const auto vec_end = std::to_address(vec.end());
+        anchor_monitor monitor{vec_begin};
+        for (auto it = vec_begin; it != vec_end; it++) {
+            LIBHAT_RECORD_STATS(context, stats.vectors++);
+            if (context.adaptive) {
+                if (const auto sample = monitor.exceeded(it); !sample.empty()) LIBHAT_UNLIKELY {
+                    // The anchor matches too often in this region, continue from here with a better one
+                    const auto next = context.reanchored(sample);
+                    LIBHAT_RECORD_STATS(context, stats.reanchored = true);
+                    const auto resume = reinterpret_cast<const std::byte*>(it) - cmpIndex;
+                    return next.pairIndex
+                        ? find_pattern_swar<alignment, true, veccmp>(resume, end, next)
+                        : find_pattern_swar<alignment, false, veccmp>(resume, end, next);
+                }
+            }
+
+            const auto word = load_word(it);
+            auto mask = match_bytes(word, firstByte);
+
+            if constexpr (cmpeq2) {
+                // The word starting one byte later, the vectorized range always has a readable byte after it
+                const auto shifted = (word >> 8) | (load_word(it + 1) << 56);
+                mask &= match_bytes(shifted, secondByte);
+            }
+
+            if constexpr (alignment != scan_alignment::X1) {
+                mask &= alignmentMasks[(reinterpret_cast<std::uintptr_t>(it) >> 3) & 1];
+            }
+
+            if (!mask) LIBHAT_LIKELY {
+                continue;
+            }
+
+            if (context.adaptive) {
+                monitor.add(std::popcount(mask));
+            }
+            while (mask) {
+                const auto offset = static_cast<std::size_t>(std::countr_zero(mask)) >> 3;
+                const auto i = reinterpret_cast<const std::byte*>(it) + offset - cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
+                if constexpr (veccmp) {
+                    const auto match = ((load_word(i) ^ signatureBytes) & signatureMask) == 0;
+                    if (match) LIBHAT_UNLIKELY {
+                        return i;
+                    }
+                } else {
+                    const auto match = verify_packed(context, i);
+                    if (match) LIBHAT_UNLIKELY {
+                        return i;
+                    }
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        if (!post.empty()) {
+            return find_pattern_single<alignment>(post.data(), post.data() + post.size(), context);
+        }
+        return {};
+    }
+
+    template<>
+    scan_function_t resolve_scanner<scan_mode::SWAR>(scan_context& context) {
+        context.apply_hints({.vectorSize = 8});
+
+        const auto alignment = context.alignment;
+        const auto signature = context.signature;
+        const bool cmpeq2 = context.pairIndex.has_value();
+        const bool veccmp = signature.size() <= 8;
+
+        return find_specialization_switch<[]<auto... p>() consteval {
+            return &find_pattern_swar<p...>;
+        }>(alignment, cmpeq2, veccmp);
+    }
+}
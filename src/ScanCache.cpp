@@ -0,0 +1,278 @@
+#include <libhat/scan_cache.hpp>
+
+#include <libhat/system.hpp>
+
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+
+namespace hat::detail {
+
+    static constexpr std::array<char, 8> scan_cache_magic{'h', 'a', 't', 'c', 'a', 'c', 'h', '1'};
+
+    struct scan_cache_header {
+        std::array<char, 8> magic{};
+        std::uint64_t module{}; // Identifies the build of the module the offsets are valid for
+        std::uint64_t count{};  // The number of entries which follow, sorted by key
+    };
+
+    struct scan_cache_entry {
+        std::uint64_t key{};
+        std::uint64_t offset{}; // Relative to the start of the section
+    };
+
+    static_assert(sizeof(scan_cache_header) == 24 && sizeof(scan_cache_entry) == 16);
+
+    struct fnv1a {
+        std::uint64_t value = 0xCBF29CE484222325;
+
+        void update(const void* data, const std::size_t size) {
+            const auto bytes = static_cast<const std::uint8_t*>(data);
+            for (std::size_t i = 0; i < size; i++) {
+                value = (value ^ bytes[i]) * 0x100000001B3;
+            }
+        }
+
+        template<typename T> requires std::is_trivially_copyable_v<T>
+        void update(const T& object) {
+            update(&object, sizeof(object));
+        }
+    };
+
+    /// Identifies the build of a module by the build id the linker assigned to it. Modules without one are identified
+    /// by the headers at their base instead, which include the link timestamp and checksum of PE files, and the
+    /// layout of the segments of the other formats.
+    static std::uint64_t get_module_identity(const process::module& mod) {
+        fnv1a hash{};
+        if (const auto id = mod.build_id(); !id.empty()) {
+            hash.update(id.data(), id.size());
+            return hash.value;
+        }
+
+        const auto data = mod.get_module_data();
+        const auto headers = data.first(std::min(data.size(), get_system().page_size));
+        if (process::is_readable(headers)) {
+            hash.update(headers.data(), headers.size());
+        }
+        hash.update(headers.size());
+        return hash.value;
+    }
+
+    static std::uint64_t get_request_key(const scan_request& request) {
+        fnv1a hash{};
+        hash.update(request.section.size());
+        hash.update(request.section.data(), request.section.size());
+        hash.update(request.alignment);
+        hash.update(request.hints);
+        for (const auto& element : request.signature) {
+            hash.update(std::array{element.value(), element.mask()});
+        }
+        return hash.value;
+    }
+
+    /// Returns a path next to the cache file to write the new contents to, unique so that processes saving the same
+    /// cache at once don't write to the same file
+    static std::filesystem::path get_temp_path(const std::filesystem::path& path) {
+        std::random_device random{};
+        const auto suffix = (std::uint64_t{random()} << 32) | random();
+        auto temp = path;
+        temp += ".";
+        temp += std::to_string(suffix);
+        temp += ".tmp";
+        return temp;
+    }
+
+    struct scan_cache_impl {
+        std::filesystem::path path;
+        process::module mod;
+        std::uint64_t identity{};
+
+        mapped_file file{};
+        std::span<const scan_cache_entry> entries{}; // Loaded from the file
+        std::map<std::uint64_t, std::uint64_t> added{}; // Found since the file was loaded, replacing its entries
+        std::size_t hits{};
+        std::size_t misses{};
+        mutable std::mutex mutex{};
+
+        scan_cache_impl(std::filesystem::path path, process::module mod)
+            : path(std::move(path)), mod(std::move(mod)), identity(get_module_identity(this->mod)) {
+            this->load();
+        }
+
+        void load() {
+            this->entries = {};
+            this->file = mapped_file{this->path};
+            const auto data = this->file.data();
+            if (data.size() < sizeof(scan_cache_header)) {
+                return;
+            }
+
+            scan_cache_header header{};
+            std::memcpy(&header, data.data(), sizeof(header));
+            const auto available = (data.size() - sizeof(header)) / sizeof(scan_cache_entry);
+            if (header.magic != scan_cache_magic || header.module != this->identity || header.count > available) {
+                return;
+            }
+            this->entries = {
+                reinterpret_cast<const scan_cache_entry*>(data.data() + sizeof(header)),
+                static_cast<std::size_t>(header.count)
+            };
+        }
+
+        [[nodiscard]] std::optional<std::uint64_t> lookup(const std::uint64_t key) const {
+            if (const auto it = this->added.find(key); it != this->added.end()) {
+                return it->second;
+            }
+            const auto it = std::ranges::lower_bound(this->entries, key, {}, &scan_cache_entry::key);
+            if (it != this->entries.end() && it->key == key) {
+                return it->offset;
+            }
+            return std::nullopt;
+        }
+
+        /// Returns the address of a match of the request at a cached offset, or nullptr if there isn't one
+        [[nodiscard]] std::byte* verify(const scan_request& request, const std::span<std::byte> section, const std::uint64_t key) {
+            std::scoped_lock lock{this->mutex};
+            const auto offset = this->lookup(key);
+            if (!offset || *offset > section.size() || request.signature.size() > section.size() - *offset) {
+                return nullptr;
+            }
+
+            const auto address = section.data() + *offset;
+            if (reinterpret_cast<std::uintptr_t>(address) % detail::to_stride(request.alignment) != 0
+                || !std::equal(request.signature.begin(), request.signature.end(), address)) {
+                return nullptr;
+            }
+            this->hits++;
+            return address;
+        }
+
+        void insert(const std::span<std::byte> section, const std::uint64_t key, const scan_result result) {
+            std::scoped_lock lock{this->mutex};
+            this->misses++;
+            if (result.has_result()) {
+                this->added[key] = static_cast<std::uint64_t>(result.get() - section.data());
+            }
+        }
+    };
+}
+
+namespace hat {
+
+    scan_cache::scan_cache(std::filesystem::path path, process::module mod)
+        : impl(std::make_unique<detail::scan_cache_impl>(std::move(path), std::move(mod))) {}
+
+    scan_cache::~scan_cache() = default;
+    scan_cache::scan_cache(scan_cache&&) noexcept = default;
+    scan_cache& scan_cache::operator=(scan_cache&&) noexcept = default;
+
+    scan_result scan_cache::find_pattern(
+        const signature_view   signature,
+        const std::string_view section,
+        const scan_alignment   alignment,
+        const scan_hint        hints
+    ) {
+        const scan_request request{signature, section, alignment, hints};
+        const auto key = detail::get_request_key(request);
+        const auto data = this->impl->mod.get_section_data(section);
+        if (const auto address = this->impl->verify(request, data, key)) {
+            return address;
+        }
+
+        const auto result = hat::find_pattern(data.begin(), data.end(), signature, alignment, hints);
+        this->impl->insert(data, key, result);
+        return result;
+    }
+
+    std::vector<scan_result> scan_cache::resolve_all(const std::span<const scan_request> requests, const batch_options& options) {
+        std::vector<scan_result> results(requests.size());
+        std::vector<scan_request> missing{};
+        std::vector<std::size_t> missingIndices{};
+        std::vector<std::uint64_t> keys(requests.size());
+        for (std::size_t i = 0; i < requests.size(); i++) {
+            keys[i] = detail::get_request_key(requests[i]);
+            const auto data = this->impl->mod.get_section_data(requests[i].section);
+            if (const auto address = this->impl->verify(requests[i], data, keys[i])) {
+                results[i] = address;
+            } else {
+                missing.push_back(requests[i]);
+                missingIndices.push_back(i);
+            }
+        }
+
+        if (!missing.empty()) {
+            const auto scanned = hat::resolve_all(missing, this->impl->mod, options);
+            for (std::size_t i = 0; i < missing.size(); i++) {
+                const auto index = missingIndices[i];
+                results[index] = scanned[i];
+                this->impl->insert(this->impl->mod.get_section_data(missing[i].section), keys[index], scanned[i]);
+            }
+        }
+        return results;
+    }
+
+    bool scan_cache::save() {
+        auto& state = *this->impl;
+        std::scoped_lock lock{state.mutex};
+        if (state.added.empty()) {
+            return true;
+        }
+
+        std::map<std::uint64_t, std::uint64_t> merged{};
+        for (const auto& entry : state.entries) {
+            merged.emplace(entry.key, entry.offset);
+        }
+        for (const auto& [key, offset] : state.added) {
+            merged.insert_or_assign(key, offset);
+        }
+
+        std::vector<detail::scan_cache_entry> entries{};
+        entries.reserve(merged.size());
+        for (const auto& [key, offset] : merged) {
+            entries.push_back({key, offset});
+        }
+
+        // The file can't be replaced while it's mapped on every platform
+        state.entries = {};
+        state.file = {};
+
+        const auto temp = detail::get_temp_path(state.path);
+        bool written;
+        {
+            const detail::scan_cache_header header{detail::scan_cache_magic, state.identity, entries.size()};
+            std::ofstream file{temp, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(entries[0])));
+            written = static_cast<bool>(file.flush());
+        }
+
+        std::error_code ec{};
+        if (written) {
+            std::filesystem::rename(temp, state.path, ec);
+        }
+        state.load();
+        if (!written || ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        state.added.clear();
+        return true;
+    }
+
+    std::size_t scan_cache::hits() const {
+        std::scoped_lock lock{this->impl->mutex};
+        return this->impl->hits;
+    }
+
+    std::size_t scan_cache::misses() const {
+        std::scoped_lock lock{this->impl->mutex};
+        return this->impl->misses;
+    }
+}
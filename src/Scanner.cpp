@@ -3,10 +3,27 @@
 #include <libhat/defines.hpp>
 #include <libhat/system.hpp>
 
+#include "Utils.hpp"
+
+#include <atomic>
+#include <limits>
+
 #ifdef LIBHAT_HINT_X86_64
 #include "arch/x86/Frequency.hpp"
 #endif
 
+#ifdef LIBHAT_SCAN_STATS
+    #if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        #ifdef _MSC_VER
+            #include <intrin.h>
+        #else
+            #include <x86intrin.h>
+        #endif
+    #else
+        #include <chrono>
+    #endif
+#endif
+
 #ifdef LIBHAT_HINT_AARCH64
 #include "arch/arm/Frequency.hpp"
 #endif
@@ -84,34 +101,142 @@ namespace hat::detail {
         }
     }
 
-    template<>
-    scan_function_t resolve_scanner<scan_mode::Auto>(scan_context& context) {
-        const auto& ext = get_system().extensions;
-#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
-        if (compiled_extensions.bmi || ext.bmi) {
-#if defined(LIBHAT_X86_64) && defined(LIBHAT_FEATURE_AVX512)
-            if ((compiled_extensions.avx512f || ext.avx512f)
-                && (compiled_extensions.avx512bw || ext.avx512bw)) {
-                return resolve_scanner<scan_mode::AVX512>(context);
+    scan_context scan_context::reanchored(const std::span<const std::byte> sample) const {
+        std::array<std::size_t, 256> frequency{};
+        for (const auto b : sample) {
+            frequency[std::to_integer<std::uint8_t>(b)]++;
+        }
+        const auto getFrequency = [&](const signature_element& e) {
+            return frequency[std::to_integer<std::uint8_t>(e.value())];
+        };
+
+        // A pair can't match more often than its least frequent byte
+        std::optional<std::pair<std::size_t, std::size_t>> bestSingle{};
+        std::optional<std::pair<std::size_t, std::size_t>> bestPair{};
+        for (std::size_t i = 0; i < this->signature.size(); i++) {
+            const auto& a = this->signature[i];
+            if (!a.all()) {
+                continue;
             }
-#endif
-            if (compiled_extensions.avx2 || ext.avx2) {
-                return resolve_scanner<scan_mode::AVX2>(context);
+            const auto score = getFrequency(a);
+            if (!bestSingle || score < bestSingle->second) {
+                bestSingle.emplace(i, score);
+            }
+            if (i + 1 < this->signature.size() && this->signature[i + 1].all()) {
+                const auto pairScore = std::min(score, getFrequency(this->signature[i + 1]));
+                if (!bestPair || pairScore < bestPair->second) {
+                    bestPair.emplace(i, pairScore);
+                }
             }
         }
-#if defined(LIBHAT_FEATURE_SSE)
-        if (compiled_extensions.sse41 || ext.sse41) {
-            return resolve_scanner<scan_mode::SSE>(context);
+
+        scan_context ctx = *this;
+        ctx.adaptive = false;
+        if (bestPair && bestPair->second <= bestSingle->second) {
+            ctx.cmpIndex = bestPair->first;
+            ctx.pairIndex = bestPair->first;
+        } else if (bestSingle) {
+            ctx.cmpIndex = bestSingle->first;
+            ctx.pairIndex = std::nullopt;
         }
+        return ctx;
+    }
+
+#ifdef LIBHAT_SCAN_STATS
+    std::uint64_t read_cycle_counter() noexcept {
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        return __rdtsc();
+#else
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+    }
+#endif
+
+    static constinit std::array<std::atomic<scan_mode>, scan_size_class_count> preferred_scan_modes{};
+
+    scan_function_t resolve_scanner_for(const scan_mode mode, scan_context& context) {
+        switch (mode) {
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+#if defined(LIBHAT_FEATURE_SSE)
+            case scan_mode::SSE: return resolve_scanner<scan_mode::SSE>(context);
+#endif
+            case scan_mode::AVX2: return resolve_scanner<scan_mode::AVX2>(context);
+#if defined(LIBHAT_X86_64) && defined(LIBHAT_FEATURE_AVX512)
+            case scan_mode::AVX512: return resolve_scanner<scan_mode::AVX512>(context);
+            case scan_mode::AVX512VL: return resolve_scanner<scan_mode::AVX512VL>(context);
 #endif
 #endif
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+            case scan_mode::Neon: return resolve_scanner<scan_mode::Neon>(context);
+#endif
+            case scan_mode::SWAR: return resolve_scanner<scan_mode::SWAR>(context);
+            case scan_mode::Horspool: return resolve_scanner<scan_mode::Horspool>(context);
+            default: return resolve_scanner<scan_mode::Single>(context);
+        }
+    }
+
+    static const_scan_result find_pattern_by_size(const std::byte* begin, const std::byte* end, const scan_context& context) {
+        const auto sizeClass = get_scan_size_class(static_cast<std::size_t>(end - begin));
+        return context.sizeClassScanners[static_cast<std::size_t>(sizeClass)](begin, end, context);
+    }
+
+    /// The shortest run of fully masked bytes for which the Horspool scanner outpaces the anchor search of a vectorized
+    /// scanner. Each shift skips up to the length of the run, while the anchor search scales with the vector width.
+    static constexpr std::size_t get_horspool_min_window(const scan_mode vectorMode) {
+        switch (vectorMode) {
+            case scan_mode::AVX512:
+            case scan_mode::AVX512VL:
+                return std::numeric_limits<std::size_t>::max();
+            case scan_mode::AVX2:
+                return 128;
+            default:
+                return 32;
+        }
+    }
+
+    template<>
+    scan_function_t resolve_scanner<scan_mode::Auto>(scan_context& context) {
+        run_pending_scan_calibration();
+
+        // Signatures with a long run of known bytes can be found faster by skipping over the data. This takes priority
+        // over the preferred modes, as calibration only measures a signature with a short run.
+        static const auto vectorMode = get_default_scan_mode();
+        const auto exactRun = find_longest_exact_run(context.signature).size;
+        std::array<scan_mode, scan_size_class_count> modes{};
+        for (std::size_t i = 0; i < modes.size(); i++) {
+            const auto preferred = preferred_scan_modes[i].load(std::memory_order_relaxed);
+            const auto mode = preferred == scan_mode::Auto ? vectorMode : preferred;
+            modes[i] = exactRun >= get_horspool_min_window(mode) ? scan_mode::Horspool : mode;
+        }
+
+        if (std::ranges::adjacent_find(modes, std::ranges::not_equal_to{}) == modes.end()) LIBHAT_LIKELY {
+            return resolve_scanner_for(modes.front(), context);
+        }
+        for (std::size_t i = 0; i < modes.size(); i++) {
+            context.sizeClassScanners[i] = resolve_scanner_for(modes[i], context);
+        }
+        return &find_pattern_by_size;
+    }
+
+    static mismatch_function_t resolve_mismatch_counter() {
+        [[maybe_unused]] const auto& ext = get_system().extensions;
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        if ((compiled_extensions.avx2 || ext.avx2) && (compiled_extensions.popcnt || ext.popcnt)) {
+            return &count_mismatches_avx2;
+        }
+#endif
 #if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
         if (compiled_extensions.neon || ext.neon) {
-            return resolve_scanner<scan_mode::Neon>(context);
+            return &count_mismatches_neon;
         }
 #endif
-        // If none of the vectorized implementations are available/supported, then fallback to scanning per-byte
-        return resolve_scanner<scan_mode::Single>(context);
+        return &count_mismatches_single;
+    }
+
+    std::size_t count_mismatches(const std::byte* data, const signature_view signature, const std::size_t limit) {
+        static const auto counter = resolve_mismatch_counter();
+        return counter(data, signature, limit);
     }
 }
 
@@ -155,4 +280,93 @@ namespace hat {
         const auto [scan_end, results_end] = hat::find_all_pattern(a.cbegin(), a.cend(), results.begin(), results.end(), s);
         return scan_end == a.cend() && results_end == std::next(results.begin(), 2);
     }());
+
+    // Long enough for the skip table scanner, with a partial match of the run before the real one
+    static_assert([] {
+        constexpr std::array a{std::byte{5}, std::byte{1}, std::byte{2}, std::byte{3}, std::byte{5}, std::byte{7},
+            std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{8}};
+        const auto s = hat::parse_signature("? 01 02 03 04 ?").value();
+        return hat::find_pattern(a.cbegin(), a.cend(), s) == a.data() + 5;
+    }());
+
+    static_assert([] {
+        constexpr std::array a{std::byte{1}, std::byte{2}, std::byte{9}, std::byte{4}, std::byte{1}, std::byte{2}};
+        constexpr hat::fixed_signature<4> s{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}};
+
+        const auto result = hat::find_pattern_fuzzy(a.cbegin(), a.cend(), s, 1);
+        return result.result.get() == a.data() && result.mismatches == 1
+            && !hat::find_pattern_fuzzy(a.cbegin(), a.cend(), s, 0).has_result();
+    }());
+}
+
+namespace hat {
+
+    bool is_scan_mode_supported(const scan_mode mode) noexcept {
+        [[maybe_unused]] const auto& ext = get_system().extensions;
+        switch (mode) {
+            case scan_mode::Auto:
+            case scan_mode::Single:
+            case scan_mode::SWAR:
+            case scan_mode::Horspool:
+                return true;
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+#if defined(LIBHAT_FEATURE_SSE)
+            case scan_mode::SSE:
+                return compiled_extensions.sse41 || ext.sse41;
+#endif
+            case scan_mode::AVX2:
+                return (compiled_extensions.bmi || ext.bmi) && (compiled_extensions.avx2 || ext.avx2);
+#if defined(LIBHAT_X86_64) && defined(LIBHAT_FEATURE_AVX512)
+            case scan_mode::AVX512:
+                return (compiled_extensions.bmi || ext.bmi)
+                    && (compiled_extensions.avx512f || ext.avx512f)
+                    && (compiled_extensions.avx512bw || ext.avx512bw);
+            case scan_mode::AVX512VL:
+                return (compiled_extensions.bmi || ext.bmi)
+                    && (compiled_extensions.avx512f || ext.avx512f)
+                    && (compiled_extensions.avx512bw || ext.avx512bw)
+                    && (compiled_extensions.avx512vl || ext.avx512vl)
+                    && (compiled_extensions.avx512vbmi || ext.avx512vbmi);
+#endif
+#endif
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+            case scan_mode::Neon:
+                return compiled_extensions.neon || ext.neon;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    scan_mode get_default_scan_mode() noexcept {
+        for (const auto mode : {scan_mode::AVX512, scan_mode::AVX2, scan_mode::SSE, scan_mode::Neon}) {
+            if (is_scan_mode_supported(mode)) {
+                return mode;
+            }
+        }
+        // If none of the vectorized implementations are available/supported, then fallback to scanning per-word
+        return scan_mode::SWAR;
+    }
+
+    bool set_preferred_scan_mode(const scan_size_class sizeClass, const scan_mode mode) noexcept {
+        if (!is_scan_mode_supported(mode)) {
+            return false;
+        }
+        detail::preferred_scan_modes[static_cast<std::size_t>(sizeClass)].store(mode, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool set_preferred_scan_mode(const scan_mode mode) noexcept {
+        if (!is_scan_mode_supported(mode)) {
+            return false;
+        }
+        for (auto& preferred : detail::preferred_scan_modes) {
+            preferred.store(mode, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    scan_mode get_preferred_scan_mode(const scan_size_class sizeClass) noexcept {
+        return detail::preferred_scan_modes[static_cast<std::size_t>(sizeClass)].load(std::memory_order_relaxed);
+    }
 }
@@ -0,0 +1,211 @@
+#include <libhat/signature_db.hpp>
+
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+
+namespace hat::detail {
+
+    static constexpr std::array<char, 8> signature_db_magic{'h', 'a', 't', 's', 'i', 'g', 'd', 'b'};
+    static constexpr std::uint32_t signature_db_version = 2;
+
+    struct signature_db_header {
+        std::array<char, 8> magic{};
+        std::uint32_t version{};
+        std::uint32_t count{};
+    };
+
+    /// Offsets are from the start of the database, followed by the elements and the strings they refer to
+    struct signature_db_record {
+        std::uint32_t nameOffset{};
+        std::uint32_t nameSize{};
+        std::uint32_t sectionOffset{};
+        std::uint32_t sectionSize{};
+        std::uint32_t elementsOffset{};
+        std::uint32_t elementCount{};
+        std::uint64_t hints{};
+        std::uint32_t alignment{};
+        std::uint32_t reserved{};
+    };
+
+    static_assert(sizeof(signature_db_header) == 16 && sizeof(signature_db_record) == 40);
+    static_assert(sizeof(signature_element) == 2 && alignof(signature_element) == 1);
+    static_assert(std::is_trivially_copyable_v<signature_element>);
+
+    static signature_db_record read_record(const std::span<const std::byte> data, const std::size_t index) {
+        signature_db_record record{};
+        std::memcpy(&record, data.data() + sizeof(signature_db_header) + index * sizeof(record), sizeof(record));
+        return record;
+    }
+
+    static std::string_view read_string(const std::span<const std::byte> data, const std::uint32_t offset, const std::uint32_t size) {
+        return {reinterpret_cast<const char*>(data.data() + offset), size};
+    }
+
+    static bool in_bounds(const std::span<const std::byte> data, const std::uint64_t offset, const std::uint64_t size) {
+        return offset <= data.size() && size <= data.size() - offset;
+    }
+
+    /// Checks that the records only refer to data within the database, and that the elements hold their invariants.
+    /// Returns the number of entries, or std::nullopt if the database is invalid.
+    static std::optional<std::size_t> validate_signature_db(const std::span<const std::byte> data) {
+        signature_db_header header{};
+        if (data.size() < sizeof(header)) {
+            return std::nullopt;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != signature_db_magic || header.version != signature_db_version
+            || !in_bounds(data, sizeof(header), std::uint64_t{header.count} * sizeof(signature_db_record))) {
+            return std::nullopt;
+        }
+
+        std::string_view previous{};
+        for (std::size_t i = 0; i < header.count; i++) {
+            const auto record = read_record(data, i);
+            if (!in_bounds(data, record.nameOffset, record.nameSize)
+                || !in_bounds(data, record.sectionOffset, record.sectionSize)
+                || !in_bounds(data, record.elementsOffset, std::uint64_t{record.elementCount} * sizeof(signature_element))) {
+                return std::nullopt;
+            }
+            if (record.alignment != 1 && record.alignment != 4 && record.alignment != 16) {
+                return std::nullopt;
+            }
+
+            const auto name = read_string(data, record.nameOffset, record.nameSize);
+            if (i != 0 && name < previous) {
+                return std::nullopt;
+            }
+            previous = name;
+
+            // Masked bits of the values must be zero, as they would be after construction. Like a parsed signature,
+            // the elements can't be empty and must include a fully masked byte.
+            const auto elements = data.subspan(record.elementsOffset, record.elementCount * sizeof(signature_element));
+            bool anchored = false;
+            for (std::size_t j = 0; j < elements.size(); j += 2) {
+                if ((elements[j] & ~elements[j + 1]) != std::byte{0}) {
+                    return std::nullopt;
+                }
+                anchored |= elements[j + 1] == std::byte{0xFF};
+            }
+            if (!anchored) {
+                return std::nullopt;
+            }
+        }
+        return header.count;
+    }
+}
+
+namespace hat {
+
+    result<std::vector<std::byte>, signature_db_error> compile_signature_db(const std::span<const signature_db_source> sources) {
+        std::vector<signature> signatures{};
+        signatures.reserve(sources.size());
+        for (std::size_t i = 0; i < sources.size(); i++) {
+            auto parsed = parse_signature(sources[i].signature);
+            if (!parsed.has_value()) {
+                return result_error{signature_db_error{i, parsed.error()}};
+            }
+            signatures.push_back(std::move(parsed).value());
+        }
+
+        std::vector<std::size_t> order(sources.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::ranges::stable_sort(order, {}, [&](const std::size_t i) { return sources[i].name; });
+
+        std::size_t elementsSize{};
+        for (const auto& signature : signatures) {
+            elementsSize += signature.size() * sizeof(signature_element);
+        }
+        const auto elementsBase = sizeof(detail::signature_db_header) + sources.size() * sizeof(detail::signature_db_record);
+
+        std::vector<std::byte> data(elementsBase + elementsSize);
+        const auto appendString = [&](const std::string_view str) {
+            const auto offset = data.size();
+            const auto bytes = std::as_bytes(std::span{str});
+            data.insert(data.end(), bytes.begin(), bytes.end());
+            return static_cast<std::uint32_t>(offset);
+        };
+
+        const detail::signature_db_header header{
+            detail::signature_db_magic,
+            detail::signature_db_version,
+            static_cast<std::uint32_t>(sources.size())
+        };
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        auto elementsOffset = elementsBase;
+        for (std::size_t i = 0; i < order.size(); i++) {
+            const auto& source = sources[order[i]];
+            const auto& signature = signatures[order[i]];
+            std::memcpy(data.data() + elementsOffset, signature.data(), signature.size() * sizeof(signature_element));
+
+            const detail::signature_db_record record{
+                .nameOffset = appendString(source.name),
+                .nameSize = static_cast<std::uint32_t>(source.name.size()),
+                .sectionOffset = appendString(source.section),
+                .sectionSize = static_cast<std::uint32_t>(source.section.size()),
+                .elementsOffset = static_cast<std::uint32_t>(elementsOffset),
+                .elementCount = static_cast<std::uint32_t>(signature.size()),
+                .hints = static_cast<std::uint64_t>(source.hints),
+                .alignment = detail::to_stride(source.alignment),
+            };
+            std::memcpy(data.data() + sizeof(header) + i * sizeof(record), &record, sizeof(record));
+            elementsOffset += signature.size() * sizeof(signature_element);
+        }
+        return data;
+    }
+
+    std::optional<signature_db> signature_db::open(const std::filesystem::path& path) {
+        auto file = std::make_shared<detail::mapped_file>(path);
+        const auto data = file->data();
+        if (const auto count = detail::validate_signature_db(data)) {
+            return signature_db{std::move(file), data, *count};
+        }
+        return std::nullopt;
+    }
+
+    std::optional<signature_db> signature_db::from_bytes(const std::span<const std::byte> data) {
+        if (const auto count = detail::validate_signature_db(data)) {
+            return signature_db{nullptr, data, *count};
+        }
+        return std::nullopt;
+    }
+
+    signature_db_entry signature_db::operator[](const std::size_t index) const noexcept {
+        const auto record = detail::read_record(this->data, index);
+        return {
+            .name = detail::read_string(this->data, record.nameOffset, record.nameSize),
+            .signature = {
+                reinterpret_cast<const signature_element*>(this->data.data() + record.elementsOffset),
+                record.elementCount
+            },
+            .section = detail::read_string(this->data, record.sectionOffset, record.sectionSize),
+            .alignment = static_cast<scan_alignment>(record.alignment),
+            .hints = static_cast<scan_hint>(record.hints),
+        };
+    }
+
+    std::optional<signature_db_entry> signature_db::find(const std::string_view name) const noexcept {
+        const auto indices = std::views::iota(std::size_t{0}, this->count);
+        const auto it = std::ranges::lower_bound(indices, name, {}, [&](const std::size_t i) {
+            const auto record = detail::read_record(this->data, i);
+            return detail::read_string(this->data, record.nameOffset, record.nameSize);
+        });
+        if (it == indices.end() || (*this)[*it].name != name) {
+            return std::nullopt;
+        }
+        return (*this)[*it];
+    }
+
+    std::vector<scan_request> signature_db::requests() const {
+        std::vector<scan_request> requests{};
+        requests.reserve(this->count);
+        for (std::size_t i = 0; i < this->count; i++) {
+            requests.push_back((*this)[i].to_request());
+        }
+        return requests;
+    }
+}
@@ -0,0 +1,189 @@
+#include <libhat/signature_list.hpp>
+#include <libhat/system.hpp>
+
+#include "SignatureList.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <optional>
+
+namespace hat::detail {
+
+    static void classify_signature_text_single(const char* text, const std::size_t blocks, signature_text_block* out, std::uint8_t* nibbles) {
+        for (std::size_t block = 0; block < blocks; block++) {
+            signature_text_block bits{};
+            for (std::size_t i = 0; i < signature_text_block_size; i++) {
+                const auto offset = block * signature_text_block_size + i;
+                const auto ch = static_cast<std::uint8_t>(text[offset]);
+                const auto classes = signature_char_low_nibble[ch & 0x0F] & signature_char_high_nibble[ch >> 4];
+                const auto bit = std::uint64_t{1} << i;
+                bits.hex |= (classes & (char_digit | char_letter)) ? bit : 0;
+                bits.wildcard |= (classes & char_wildcard) ? bit : 0;
+                bits.newline |= (classes & char_newline) ? bit : 0;
+                bits.cr |= (classes & char_cr) ? bit : 0;
+                bits.other |= classes == 0 ? bit : 0;
+                nibbles[offset] = static_cast<std::uint8_t>((ch & 0x0F) + ((classes & char_letter) ? 9 : 0));
+            }
+            out[block] = bits;
+        }
+    }
+
+    using classify_function_t = void(*)(const char*, std::size_t, signature_text_block*, std::uint8_t*);
+
+    static classify_function_t resolve_classify() {
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        if (compiled_extensions.ssse3 || get_system().extensions.ssse3) {
+            return &classify_signature_text_ssse3;
+        }
+#endif
+        return &classify_signature_text_single;
+    }
+
+    /// Signature text with the class of every character, padded with spaces to a whole number of blocks
+    struct signature_text {
+        explicit signature_text(const std::string_view text) {
+            static constexpr auto blockSize = signature_text_block_size;
+            static const auto classify = resolve_classify();
+
+            const auto full = text.size() / blockSize;
+            const auto count = (text.size() + blockSize - 1) / blockSize;
+            this->blocks.resize(count);
+            this->nibbles.resize(count * blockSize + 1); // A token starting at the last character reads one past it
+            classify(text.data(), full, this->blocks.data(), this->nibbles.data());
+            if (full != count) {
+                std::array<char, blockSize> tail{};
+                tail.fill(' ');
+                std::memcpy(tail.data(), text.data() + full * blockSize, text.size() - full * blockSize);
+                classify(tail.data(), 1, this->blocks.data() + full, this->nibbles.data() + full * blockSize);
+            }
+        }
+
+        std::vector<signature_text_block> blocks{};
+        std::vector<std::uint8_t> nibbles{};
+    };
+
+    /// The tokens of a block, derived from the classes of its characters and the next block. A token is a run of hex
+    /// digits and wildcards, and the bits are set at its first character.
+    struct signature_token_block {
+        std::uint64_t starts{};
+        std::uint64_t knownHigh{}; // The first character is a hex digit
+        std::uint64_t knownLow{};  // The token has two characters, and the second is a hex digit
+        std::uint64_t invalid{};   // Anything only parse_signature_to handles, and all errors
+
+        signature_token_block(const signature_text_block& block, const signature_text_block& next, const std::uint64_t carry) {
+            const auto tokens = block.hex | block.wildcard;
+            const auto nextTokens = next.hex | next.wildcard;
+            const auto second = (tokens >> 1) | (nextTokens << 63);
+            const auto third = (tokens >> 2) | (nextTokens << 62);
+            const auto secondHex = (block.hex >> 1) | (next.hex << 63);
+
+            this->starts = tokens & ~((tokens << 1) | carry);
+            this->knownHigh = this->starts & block.hex;
+            this->knownLow = this->starts & secondHex & ~third;
+
+            // Single characters other than '?', tokens longer than two characters, and carriage returns that don't end
+            // the line, which parse_signature_to would see as part of a token
+            const auto nextNewline = (block.newline >> 1) | (next.newline << 63);
+            this->invalid = (this->starts & ~second & ~block.wildcard)
+                | (this->starts & second & third)
+                | block.other
+                | (block.cr & ~nextNewline);
+        }
+    };
+}
+
+namespace hat {
+
+    result<signature_list, signature_list_error> parse_signature_list(const std::string_view text) {
+        const detail::signature_text classified{text};
+        signature_list list{};
+
+        // Every element takes at least one character and a separator, except for the last one
+        list.elements.resize((text.size() + 1) / 2);
+        auto* const elements = list.elements.data();
+        std::size_t written = 0;
+
+        std::size_t line = 0;
+        std::size_t lineBegin = 0;
+        std::size_t lineElements = 0; // The index of the first element of the current line
+        bool fallback = false;        // The line needs to be parsed by parse_signature_to
+        bool containsByte = false;
+        signature parsed{};
+
+        const auto finish_line = [&](const std::size_t lineEnd) -> std::optional<signature_error> {
+            auto end = lineEnd;
+            if (end != lineBegin && text[end - 1] == '\r') {
+                end--;
+            }
+            if (fallback || (written != lineElements && !containsByte)) {
+                parsed.clear();
+                const auto result = parse_signature_to(std::back_inserter(parsed), text.substr(lineBegin, end - lineBegin));
+                if (!result.has_value()) {
+                    return result.error();
+                }
+                written = lineElements + parsed.size();
+                std::ranges::copy(parsed, elements + lineElements);
+            }
+            if (written != lineElements) {
+                list.offsets.push_back(written);
+                list.lines.push_back(line);
+            }
+            line++;
+            lineBegin = lineEnd + 1;
+            lineElements = written;
+            fallback = false;
+            containsByte = false;
+            return std::nullopt;
+        };
+
+        const auto& blocks = classified.blocks;
+        const auto* const nibbles = classified.nibbles.data();
+        std::uint64_t carry{};
+        for (std::size_t index = 0; index < blocks.size(); index++) {
+            const auto& block = blocks[index];
+            const detail::signature_token_block tokens{block, index + 1 < blocks.size() ? blocks[index + 1] : detail::signature_text_block{}, carry};
+            carry = (block.hex | block.wildcard) >> 63;
+
+            // The tokens up to the next newline or invalid character are emitted without branching on their contents
+            const auto base = index * detail::signature_text_block_size;
+            auto starts = tokens.starts & ~tokens.invalid;
+            auto events = tokens.invalid | block.newline;
+            while (true) {
+                const auto before = events ? (events & (~events + 1)) - 1 : ~std::uint64_t{0};
+                if (!fallback) {
+                    for (auto run = starts & before; run; run &= run - 1) {
+                        const auto offset = static_cast<std::size_t>(std::countr_zero(run));
+                        const auto pos = base + offset;
+                        const auto mask = ((tokens.knownHigh >> offset) & 1) * 0xF0 | ((tokens.knownLow >> offset) & 1) * 0x0F;
+                        const auto value = (nibbles[pos] << 4) | (nibbles[pos + 1] & 0x0F);
+                        elements[written++] = signature_element{std::byte(value), std::byte(mask)};
+                    }
+                    containsByte |= (starts & before & tokens.knownHigh & tokens.knownLow) != 0;
+                }
+                starts &= ~before;
+                if (!events) {
+                    break;
+                }
+
+                const auto offset = static_cast<std::size_t>(std::countr_zero(events));
+                if ((block.newline >> offset) & 1) {
+                    if (const auto error = finish_line(base + offset)) {
+                        return result_error{signature_list_error{line, *error}};
+                    }
+                } else {
+                    fallback = true;
+                }
+                events &= events - 1;
+            }
+        }
+        if (lineBegin < text.size()) {
+            if (const auto error = finish_line(text.size())) {
+                return result_error{signature_list_error{line, *error}};
+            }
+        }
+        list.elements.resize(written);
+        return list;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hat::detail {
+
+    /// The classes of the characters in a block of 64 characters of signature text, one bit per character. Spaces
+    /// are the only characters without a bit.
+    struct signature_text_block {
+        std::uint64_t hex{};
+        std::uint64_t wildcard{};
+        std::uint64_t newline{};
+        std::uint64_t cr{};
+        std::uint64_t other{};
+    };
+
+    inline constexpr std::size_t signature_text_block_size = 64;
+
+    enum signature_char_class : std::uint8_t {
+        char_digit    = 0x01,
+        char_letter   = 0x02, // A-F and a-f
+        char_wildcard = 0x04,
+        char_space    = 0x08,
+        char_newline  = 0x10,
+        char_cr       = 0x20,
+    };
+
+    // The class of a character is the intersection of the entries for its low and high nibble. These fit the 16 byte
+    // lookups of pshufb, and non-ASCII characters have a high nibble without any classes.
+    inline constexpr std::array<std::uint8_t, 16> signature_char_low_nibble{
+        char_digit | char_space, // '0' ' '
+        char_digit | char_letter, char_digit | char_letter, char_digit | char_letter,
+        char_digit | char_letter, char_digit | char_letter, char_digit | char_letter,
+        char_digit, char_digit, char_digit,
+        char_newline,
+        0, 0,
+        char_cr,
+        0,
+        char_wildcard,           // '?'
+    };
+
+    inline constexpr std::array<std::uint8_t, 16> signature_char_high_nibble{
+        char_newline | char_cr,
+        0,
+        char_space,
+        char_digit | char_wildcard,
+        char_letter,
+        0,
+        char_letter,
+        0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+
+    /// Classifies "blocks" full blocks of text, and writes the value of each character as a hex digit to "nibbles".
+    /// The nibbles of characters which aren't hex digits are unspecified.
+    void classify_signature_text_ssse3(const char* text, std::size_t blocks, signature_text_block* out, std::uint8_t* nibbles);
+}
@@ -3,6 +3,7 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <span>
 #include <tuple>
 
@@ -10,6 +11,22 @@
 
 namespace hat::detail {
 
+    using mismatch_function_t = std::size_t(*)(const std::byte* data, signature_view signature, std::size_t limit);
+
+    /// Resolves the scanner of a specific mode at runtime, falling back to scan_mode::Single if it isn't compiled in
+    scan_function_t resolve_scanner_for(scan_mode mode, scan_context& context);
+
+    /// Runs the calibration requested through enable_scan_calibration, if it hasn't run yet
+    void run_pending_scan_calibration();
+
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+    std::size_t count_mismatches_avx2(const std::byte* data, signature_view signature, std::size_t limit);
+#endif
+
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+    std::size_t count_mismatches_neon(const std::byte* data, signature_view signature, std::size_t limit);
+#endif
+
     constexpr std::uintptr_t fast_align_down(std::uintptr_t address, std::size_t alignment) {
         return address & ~static_cast<std::uintptr_t>(alignment - 1);
     }
@@ -18,6 +35,49 @@ namespace hat::detail {
         return (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
     }
 
+    /// Reads a trivially copyable value at an offset into the data, such as a header of a file. Returns false if it
+    /// isn't entirely within the data.
+    template<typename T>
+    bool read_at(const std::span<const std::byte> data, const std::size_t offset, T& value) {
+        if (offset > data.size() || sizeof(T) > data.size() - offset) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        return true;
+    }
+
+    /// Compares a word of data against the packed signature elements starting at "index", lane by lane
+    LIBHAT_FORCEINLINE bool verify_packed_word(const packed_signature& packed, const std::size_t index, const std::uint64_t data) {
+        std::uint64_t values, masks;
+        std::memcpy(&values, packed.values.data() + index, sizeof(values));
+        std::memcpy(&masks, packed.masks.data() + index, sizeof(masks));
+        return ((data ^ values) & masks) == 0;
+    }
+
+    /// Checks whether the signature of the context matches the data, comparing the packed elements a word at a time
+    /// instead of one element at a time. Only reads the bytes covered by the signature.
+    LIBHAT_FORCEINLINE bool verify_packed(const scan_context& context, const std::byte* data) {
+        const auto& packed = context.packed;
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= packed.size; i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            if (!verify_packed_word(packed, i, word)) {
+                return false;
+            }
+        }
+        if (i < packed.size) {
+            // The padding elements match the zeroed bytes past the end of the signature
+            std::uint64_t word{};
+            std::memcpy(&word, data + i, packed.size - i);
+            if (!verify_packed_word(packed, i, word)) {
+                return false;
+            }
+        }
+        const auto rest = context.signature.subspan(packed.size);
+        return std::equal(rest.begin(), rest.end(), data + packed.size);
+    }
+
     template<auto impl>
     auto* find_specialization_switch(const scan_alignment alignment, const bool cmpeq2, const bool veccmp) {
         const auto with_alignment = [&]<scan_alignment A>(std::integral_constant<scan_alignment, A>) {
@@ -36,6 +96,37 @@ namespace hat::detail {
         LIBHAT_UNREACHABLE();
     }
 
+    /// Counts the anchor matches found by a vectorized scanner in each block of vectors. Padding and zero-filled
+    /// tables can make an anchor match nearly everywhere, in which case the scanner should switch anchors.
+    template<typename Vector>
+    class anchor_monitor {
+    public:
+        static constexpr std::size_t block_size = 4096;
+        static constexpr std::size_t max_candidates = block_size / 16;
+
+        explicit anchor_monitor(const Vector* begin) : blockBegin(begin) {}
+
+        LIBHAT_FORCEINLINE void add(const int count) {
+            this->candidates += static_cast<std::size_t>(count);
+        }
+
+        /// Called before scanning each vector. Returns the block ending at "it" if it has too many candidates.
+        LIBHAT_FORCEINLINE std::span<const std::byte> exceeded(const Vector* it) {
+            if (static_cast<std::size_t>(it - this->blockBegin) * sizeof(Vector) < block_size) LIBHAT_LIKELY {
+                return {};
+            }
+            const std::span sample{reinterpret_cast<const std::byte*>(this->blockBegin), reinterpret_cast<const std::byte*>(it)};
+            const bool exceeded = this->candidates > max_candidates;
+            this->blockBegin = it;
+            this->candidates = 0;
+            return exceeded ? sample : std::span<const std::byte>{};
+        }
+
+    private:
+        const Vector* blockBegin;
+        std::size_t candidates{};
+    };
+
     template<typename Vector, std::size_t alignment, bool veccmp>
     LIBHAT_FORCEINLINE auto segment_scan(
         const std::byte* begin,
@@ -0,0 +1,323 @@
+#include <libhat/xref.hpp>
+#include <libhat/system.hpp>
+
+#include "Utils.hpp"
+#include "Xrefs.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+namespace hat::detail {
+
+    static constexpr std::size_t rel32_size = sizeof(std::int32_t);
+
+    struct decoded_xref {
+        std::size_t instruction{};
+        xref_kind kind{};
+    };
+
+    /// Decodes the instruction whose rel32 displacement starts at "pos", if there is one of the kinds of xref_kind
+    static std::optional<decoded_xref> decode_xref(const std::byte* data, const std::size_t pos) {
+        const auto b1 = std::to_integer<std::uint8_t>(data[pos - 1]);
+        if (b1 == 0xE8) {
+            return decoded_xref{pos - 1, xref_kind::call};
+        }
+        if (b1 == 0xE9) {
+            return decoded_xref{pos - 1, xref_kind::jmp};
+        }
+        if (pos < 2) {
+            return std::nullopt;
+        }
+
+        const auto b2 = std::to_integer<std::uint8_t>(data[pos - 2]);
+        if (b2 == 0x0F && (b1 & 0xF0) == 0x80) {
+            return decoded_xref{pos - 2, xref_kind::jcc};
+        }
+        if ((b1 & 0xC7) != 0x05) {
+            return std::nullopt;
+        }
+
+        xref_kind kind;
+        switch (b2) {
+            case 0x8D: kind = xref_kind::lea; break;
+            case 0x89:
+            case 0x8B: kind = xref_kind::mov; break;
+            case 0xFF:
+                if (b1 == 0x15) {
+                    kind = xref_kind::call_indirect;
+                } else if (b1 == 0x25) {
+                    kind = xref_kind::jmp_indirect;
+                } else {
+                    return std::nullopt;
+                }
+                break;
+            default: return std::nullopt;
+        }
+        const bool rex = pos >= 3 && (std::to_integer<std::uint8_t>(data[pos - 3]) & 0xF0) == 0x40;
+        return decoded_xref{pos - (rex ? 3 : 2), kind};
+    }
+
+    /// The sorted targets within [low, high), which is computed in 64 bits, where it can't overflow
+    static std::span<const std::uintptr_t> targets_within(const std::span<const std::uintptr_t> targets, const std::uint64_t low, const std::uint64_t high) {
+        const auto widen = [](const std::uintptr_t target) { return static_cast<std::uint64_t>(target); };
+        return std::span{
+            std::ranges::lower_bound(targets, low, {}, widen),
+            std::ranges::lower_bound(targets, high, {}, widen)
+        };
+    }
+
+    using xref_candidates_function_t = std::size_t(*)(const std::byte*, std::size_t, std::size_t, xref_filter, std::vector<std::size_t>&);
+
+    static xref_candidates_function_t resolve_xref_candidates() {
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+        if (compiled_extensions.avx2 || get_system().extensions.avx2) {
+            return &find_xref_candidates_avx2;
+        }
+#endif
+        return nullptr;
+    }
+
+    /// Finds the references to the sorted targets from "data", which is located at "address"
+    static std::vector<xref> find_xrefs(const std::span<const std::byte> data, const std::uintptr_t address, std::span<const std::uintptr_t> targets) {
+        if (data.size() <= rel32_size) {
+            return {};
+        }
+
+        // Only the targets within 2GiB of the data can be reached by a displacement, which is everything on 32-bit targets
+        constexpr auto reach = std::uint64_t{1} << 31;
+        const auto first = static_cast<std::uint64_t>(address) + rel32_size;
+        targets = targets_within(targets, first > reach ? first - reach : 0, first + data.size() + reach);
+        if (targets.empty()) {
+            return {};
+        }
+
+        const auto span = static_cast<std::uint64_t>(targets.back() - targets.front());
+        const xref_filter filter{
+            .bias = static_cast<std::uint32_t>(targets.front() - address - rel32_size),
+            .limit = static_cast<std::uint32_t>(std::min<std::uint64_t>(span, std::numeric_limits<std::uint32_t>::max()))
+        };
+
+        std::vector<xref> results{};
+        const auto check = [&](const std::size_t pos) {
+            std::int32_t disp;
+            std::memcpy(&disp, data.data() + pos, sizeof(disp));
+            if (static_cast<std::uint32_t>(disp) + static_cast<std::uint32_t>(pos) - filter.bias > filter.limit) {
+                return;
+            }
+            const auto target = address + pos + rel32_size + static_cast<std::uintptr_t>(static_cast<std::intptr_t>(disp));
+            if (!std::ranges::binary_search(targets, target)) {
+                return;
+            }
+            if (const auto decoded = decode_xref(data.data(), pos)) {
+                results.push_back(xref{data.data() + decoded->instruction, target, decoded->kind});
+            }
+        };
+
+        // Displacements follow at least one opcode byte, and have to be entirely within the data
+        static const auto vectorized = resolve_xref_candidates();
+        const auto end = data.size() - rel32_size + 1;
+        std::size_t pos = 1;
+        if (vectorized) {
+            check(pos++);
+            std::vector<std::size_t> candidates{};
+            pos = vectorized(data.data(), pos, end, filter, candidates);
+            for (const auto candidate : candidates) {
+                check(candidate);
+            }
+        }
+        for (; pos < end; pos++) {
+            check(pos);
+        }
+        return results;
+    }
+
+    static constexpr std::size_t adrp_pair_window = 8;
+
+    static std::uint32_t load_word(const std::byte* data) {
+        std::uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return word;
+    }
+
+    /// Returns whether the instruction can overwrite the general purpose register "reg" or change the flow of control.
+    /// Encodings that aren't recognized are assumed to.
+    static bool clobbers_register(const std::uint32_t word, const std::uint32_t reg) {
+        const auto rt = word & 0x1F;
+        const auto rn = (word >> 5) & 0x1F;
+        if ((word & 0x1C000000) == 0x10000000 || (word & 0x0E000000) == 0x0A000000) { // Data processing
+            return rt == reg;
+        }
+        if ((word & 0x1C000000) == 0x14000000) { // Branches, exception generating and system instructions
+            return (word & 0xFFFFF01F) != 0xD503201F; // Except hints, such as NOP
+        }
+        if ((word & 0x0E000000) == 0x0E000000) { // SIMD&FP data processing
+            const bool toInteger = (word & 0x5F20FC00) == 0x1E200000; // Conversions between FP and integer registers
+            const bool move = (word & 0xBFE0EC00) == 0x0E002C00;     // SMOV and UMOV
+            return (toInteger || move) && rt == reg;
+        }
+        if ((word & 0x0A000000) != 0x08000000) { // Reserved, SME and SVE
+            return true;
+        }
+
+        // Loads and stores, which write the base register back in some addressing modes
+        const bool simd = (word >> 26) & 1;
+        if ((word & 0x3F000000) == 0x08000000) { // Exclusive and ordered, the stores write a status register
+            return rt == reg || ((word >> 16) & 0x1F) == reg;
+        }
+        if ((word & 0x3B000000) == 0x18000000) { // Literal
+            return !simd && rt == reg;
+        }
+        if ((word & 0x3A000000) == 0x28000000) { // Pair
+            const bool load = (word >> 22) & 1;
+            const bool writeback = (word >> 23) & 1;
+            return (writeback && rn == reg) || (load && !simd && (rt == reg || ((word >> 10) & 0x1F) == reg));
+        }
+        if ((word & 0x3A000000) == 0x38000000) { // Single register
+            const bool unsignedOffset = (word >> 24) & 1;
+            const bool imm9 = !unsignedOffset && !((word >> 21) & 1);
+            const bool writeback = imm9 && ((word >> 10) & 1);
+            const bool atomic = !unsignedOffset && !imm9 && ((word >> 10) & 3) == 0;
+            const bool load = ((word >> 22) & 3) != 0 || atomic;
+            return (writeback && rn == reg) || (load && !simd && rt == reg);
+        }
+        if ((word & 0xBE000000) == 0x0C000000) { // SIMD structures, post-indexed forms write the base back
+            return ((word >> 23) & 1) && rn == reg;
+        }
+        return true;
+    }
+
+    /// Finds the instruction adding the page offset to the register of the ADRP at index "adrp", and resolves it.
+    /// Instructions in between which neither use the page nor overwrite its register are skipped.
+    static std::optional<std::pair<std::uintptr_t, xref_kind>> decode_adrp_pair(const std::byte* words, const std::size_t count, const std::size_t adrp, const std::uintptr_t page) {
+        const auto reg = load_word(words + adrp * 4) & 0x1F;
+        if (reg == 31) {
+            return std::nullopt;
+        }
+        for (auto i = adrp + 1; i < count && i <= adrp + adrp_pair_window; i++) {
+            const auto word = load_word(words + i * 4);
+            if (((word >> 5) & 0x1F) == reg) {
+                const auto imm12 = static_cast<std::uintptr_t>((word >> 10) & 0xFFF);
+                if ((word & 0xFFC00000) == 0x91000000) { // ADD (immediate), 64-bit, unshifted
+                    return std::pair{page + imm12, xref_kind::adrp_add};
+                }
+                if ((word & 0x3B000000) == 0x39000000) { // LDR/STR (immediate, unsigned offset), including SIMD&FP registers
+                    const auto size = word >> 30;
+                    const auto simd = (word >> 26) & 1;
+                    const auto opc = (word >> 22) & 3;
+                    const auto scale = simd && (opc & 2) ? 4 : size;
+                    const bool load = simd ? (opc & 1) != 0 : opc != 0;
+                    return std::pair{page + (imm12 << scale), load ? xref_kind::adrp_ldr : xref_kind::adrp_str};
+                }
+            }
+            if (clobbers_register(word, reg)) {
+                return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    }
+
+    using xref_candidates_aarch64_function_t = std::size_t(*)(const std::byte*, std::size_t, std::uint32_t, const xref_filter_aarch64&, std::vector<std::size_t>&);
+
+    static xref_candidates_aarch64_function_t resolve_xref_candidates_aarch64() {
+        [[maybe_unused]] const auto& ext = get_system().extensions;
+#if (defined(LIBHAT_X86) || defined(LIBHAT_X86_64)) && defined(LIBHAT_FEATURE_SSE)
+        if (compiled_extensions.sse41 || ext.sse41) {
+            return &find_xref_candidates_aarch64_sse;
+        }
+#endif
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+        if (compiled_extensions.neon || ext.neon) {
+            return &find_xref_candidates_aarch64_neon;
+        }
+#endif
+        return nullptr;
+    }
+
+    /// Finds the references to the sorted targets from the instructions in "data", which is located at "address"
+    static std::vector<xref> find_xrefs_aarch64(const std::span<const std::byte> data, const std::uintptr_t address, const std::span<const std::uintptr_t> targets) {
+        // Instructions are aligned to 4 bytes in memory
+        const auto skip = static_cast<std::size_t>(fast_align_up(address, 4) - address);
+        if (data.size() < skip || targets.empty()) {
+            return {};
+        }
+        const auto* const words = data.data() + skip;
+        const auto count = (data.size() - skip) / 4;
+        const auto pc = address + skip;
+
+        // B and BL reach 128MiB, and ADRP reaches 4GiB in either direction
+        const auto first = static_cast<std::uint64_t>(pc);
+        const auto last = first + count * 4;
+        constexpr auto branchReach = std::uint64_t{1} << 27;
+        constexpr auto pageReach = std::uint64_t{1} << 32;
+        const auto branchTargets = targets_within(targets, first > branchReach ? first - branchReach : 0, last + branchReach);
+        const auto pageTargets = targets_within(targets, first > pageReach ? first - pageReach : 0, last + pageReach);
+
+        constexpr auto never = std::numeric_limits<std::uint32_t>::max();
+        xref_filter_aarch64 filter{.branchOpcode = never, .adrpOpcode = never};
+        if (!branchTargets.empty()) {
+            const auto span = static_cast<std::uint64_t>(branchTargets.back() - branchTargets.front());
+            filter.branchOpcode = 0x14000000;
+            filter.branchBias = static_cast<std::uint32_t>(branchTargets.front());
+            filter.branchLimit = span < (std::uint64_t{1} << 28) ? static_cast<std::uint32_t>(span * 16 + 15) : never;
+        }
+        if (!pageTargets.empty()) {
+            const auto low = fast_align_down(pageTargets.front(), 0x1000);
+            const auto span = static_cast<std::uint64_t>(fast_align_down(pageTargets.back(), 0x1000) - low);
+            filter.adrpOpcode = 0x90000000;
+            filter.pageBias = static_cast<std::uint32_t>(low);
+            filter.pageLimit = static_cast<std::uint32_t>(std::min<std::uint64_t>(span, never));
+        }
+
+        std::vector<std::size_t> candidates{};
+        std::size_t i = 0;
+        static const auto vectorized = resolve_xref_candidates_aarch64();
+        if (vectorized) {
+            i = vectorized(words, count, static_cast<std::uint32_t>(pc), filter, candidates);
+        }
+        for (; i < count; i++) {
+            if (is_xref_candidate_aarch64(load_word(words + i * 4), static_cast<std::uint32_t>(pc + i * 4), filter)) {
+                candidates.push_back(i);
+            }
+        }
+
+        std::vector<xref> results{};
+        for (const auto index : candidates) {
+            const auto word = load_word(words + index * 4);
+            const auto instruction = pc + index * 4;
+            std::optional<std::pair<std::uintptr_t, xref_kind>> resolved{};
+            if ((word & 0x7C000000) == 0x14000000) {
+                const auto offset = static_cast<std::int64_t>(static_cast<std::int32_t>(word << 6) >> 6) * 4;
+                resolved.emplace(instruction + static_cast<std::uintptr_t>(offset), word >> 31 ? xref_kind::bl : xref_kind::b);
+            } else {
+                const auto imm21 = static_cast<std::int32_t>(((word >> 3) & 0x1FFFFC) | ((word >> 29) & 3));
+                const auto offset = static_cast<std::int64_t>((imm21 << 11) >> 11) * 0x1000;
+                resolved = decode_adrp_pair(words, count, index, fast_align_down(instruction, 0x1000) + static_cast<std::uintptr_t>(offset));
+            }
+            if (resolved && std::ranges::binary_search(targets, resolved->first)) {
+                results.push_back(xref{words + index * 4, resolved->first, resolved->second});
+            }
+        }
+        return results;
+    }
+}
+
+namespace hat {
+
+    std::vector<xref> find_xrefs(const std::span<const std::byte> data, const std::uintptr_t target) {
+        return detail::find_xrefs(data, reinterpret_cast<std::uintptr_t>(data.data()), std::span{&target, 1});
+    }
+
+    std::vector<xref> find_xrefs(const std::span<const std::byte> data, const std::span<const std::uintptr_t> targets) {
+        return detail::find_xrefs(data, reinterpret_cast<std::uintptr_t>(data.data()), targets);
+    }
+
+    std::vector<xref> find_xrefs_aarch64(const std::span<const std::byte> data, const std::uintptr_t target) {
+        return detail::find_xrefs_aarch64(data, reinterpret_cast<std::uintptr_t>(data.data()), std::span{&target, 1});
+    }
+
+    std::vector<xref> find_xrefs_aarch64(const std::span<const std::byte> data, const std::span<const std::uintptr_t> targets) {
+        return detail::find_xrefs_aarch64(data, reinterpret_cast<std::uintptr_t>(data.data()), targets);
+    }
+}
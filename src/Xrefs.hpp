@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hat::detail {
+
+    /// The rel32 displacement at a position, added to the position, has to be at most "limit" past "bias" modulo 2^32
+    /// for the instruction to refer to one of the targets
+    struct xref_filter {
+        std::uint32_t bias{};
+        std::uint32_t limit{};
+    };
+
+    /// Appends the displacement positions in [begin, end) which pass the filter and follow one of the opcodes of
+    /// xref_kind to "out", 32 at a time, and returns the position it stopped at. Requires "begin" to be at least 2 and
+    /// "end" to be at least 3 bytes before the end of the data.
+    std::size_t find_xref_candidates_avx2(const std::byte* data, std::size_t begin, std::size_t end, xref_filter filter, std::vector<std::size_t>& out);
+
+    /// The filters for AArch64 instruction words. The opcodes are 0xFFFFFFFF if no target is in range of the instruction.
+    struct xref_filter_aarch64 {
+        std::uint32_t branchOpcode{}; // B and BL without the link bit
+        std::uint32_t branchBias{};   // The lowest branch target
+        std::uint32_t branchLimit{};  // 16 times the distance to the highest branch target plus 15, so that the 26-bit
+                                      // offset can be tested modulo 2^32 in its own lane
+        std::uint32_t adrpOpcode{};
+        std::uint32_t pageBias{};     // The page of the lowest ADRP target
+        std::uint32_t pageLimit{};    // The distance to the page of the highest ADRP target
+    };
+
+    /// Whether the instruction word at "pc" can refer to one of the targets of the filter. Only the low 32 bits of the
+    /// addresses are compared, which the vectorized implementations do lane by lane.
+    inline bool is_xref_candidate_aarch64(const std::uint32_t word, const std::uint32_t pc, const xref_filter_aarch64& filter) {
+        const bool branch = (word & 0x7C000000) == filter.branchOpcode
+            && (word << 6) + ((pc - filter.branchBias) << 4) <= filter.branchLimit;
+        const auto page = ((word << 9) & 0xFFFFC000) | ((word >> 17) & 0x3000);
+        const bool adrp = (word & 0x9F000000) == filter.adrpOpcode
+            && page + (pc & ~0xFFFu) - filter.pageBias <= filter.pageLimit;
+        return branch || adrp;
+    }
+
+    /// Appends the indices of the candidate words in [0, count) to "out", 4 at a time, and returns the index it stopped
+    /// at. The first word is located at "pc".
+    std::size_t find_xref_candidates_aarch64_sse(const std::byte* data, std::size_t count, std::uint32_t pc, const xref_filter_aarch64& filter, std::vector<std::size_t>& out);
+    std::size_t find_xref_candidates_aarch64_neon(const std::byte* data, std::size_t count, std::uint32_t pc, const xref_filter_aarch64& filter, std::vector<std::size_t>& out);
+}
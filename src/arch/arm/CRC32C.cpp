@@ -0,0 +1,45 @@
+#include "../../Hash.hpp"
+
+#ifdef LIBHAT_CRC32C_ARM
+
+#include <cstring>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#else
+    #include <arm_acle.h>
+#endif
+
+namespace hat::detail {
+
+    std::uint32_t crc32c_arm(std::uint32_t crc, const std::byte* data, std::size_t size) {
+        // Three independent streams hide the latency of the crc32c instructions, see crc32c_sse42
+        constexpr auto stream = crc32c_stream_size;
+        const auto word = [](const std::uint32_t c, const std::byte* ptr) {
+            std::uint64_t value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return __crc32cd(c, value);
+        };
+
+        while (size >= stream * 3) {
+            std::uint32_t crc1{}, crc2{};
+            for (std::size_t i = 0; i < stream; i += 8) {
+                crc = word(crc, data + i);
+                crc1 = word(crc1, data + stream + i);
+                crc2 = word(crc2, data + stream * 2 + i);
+            }
+            crc = crc32c_shift(crc32c_shift(crc) ^ crc1) ^ crc2;
+            data += stream * 3;
+            size -= stream * 3;
+        }
+
+        for (; size >= 8; data += 8, size -= 8) {
+            crc = word(crc, data);
+        }
+        for (; size; data++, size--) {
+            crc = __crc32cb(crc, std::to_integer<std::uint8_t>(*data));
+        }
+        return crc;
+    }
+}
+#endif
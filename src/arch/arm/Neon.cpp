@@ -24,21 +24,18 @@
 
 #ifdef LIBHAT_AARCH64
     #define LIBHAT_TEST_ZERO(x) (vmaxvq_u32(vreinterpretq_u32_u8(x)) == 0)
+    #define LIBHAT_SUM_U8(x) (vaddvq_u8(x))
 #else
     #define LIBHAT_TEST_ZERO(x) (!(vgetq_lane_u64(vreinterpretq_u64_u8(x), 0) | vgetq_lane_u64(vreinterpretq_u64_u8(x), 1)))
+    #define LIBHAT_SUM_U8(x) (vgetq_lane_u64(vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(x))), 0) \
+                            + vgetq_lane_u64(vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(x))), 1))
 #endif
 
 namespace hat::detail {
 
-    static void load_signature_128(const signature_view signature, uint8x16_t& bytes, uint8x16_t& mask) {
-        std::uint8_t byteBuffer[16]{}; // The remaining signature bytes
-        std::uint8_t maskBuffer[16]{}; // A bitmask for the signature bytes we care about
-        for (std::size_t i = 0; i < signature.size(); i++) {
-            byteBuffer[i] = std::to_integer<std::uint8_t>(signature[i].value());
-            maskBuffer[i] = std::to_integer<std::uint8_t>(signature[i].mask());
-        }
-        bytes = vld1q_u8(static_cast<const std::uint8_t*>(byteBuffer));
-        mask = vld1q_u8(static_cast<const std::uint8_t*>(maskBuffer));
+    static void load_signature_128(const packed_signature& packed, uint8x16_t& bytes, uint8x16_t& mask) {
+        bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(packed.values.data()));
+        mask = vld1q_u8(reinterpret_cast<const std::uint8_t*>(packed.masks.data()));
     }
 
     template<scan_alignment alignment>
@@ -55,6 +52,11 @@ namespace hat::detail {
         const auto signature = context.signature;
         const auto cmpIndex = cmpeq2 ? *context.pairIndex : context.cmpIndex;
 
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "Neon";
+            stats.anchor_index = cmpIndex;
+            stats.pair_index = cmpeq2 ? context.pairIndex : std::nullopt);
+
         // 128 bit vector containing first signature byte repeated
         const auto firstByte = vdupq_n_u8(static_cast<std::uint8_t>(*signature[cmpIndex]));
 
@@ -65,7 +67,7 @@ namespace hat::detail {
 
         uint8x16_t signatureBytes, signatureMask;
         if constexpr (veccmp) {
-            load_signature_128(signature, signatureBytes, signatureMask);
+            load_signature_128(context.packed, signatureBytes, signatureMask);
         }
 
         auto [pre, vec, post] = segment_scan<uint8x16_t, 16, veccmp>(begin, end, signature.size(), cmpIndex);
@@ -79,7 +81,21 @@ namespace hat::detail {
 
         const auto vec_begin = std::to_address(vec.begin());
         const auto vec_end = std::to_address(vec.end());
+        anchor_monitor monitor{vec_begin};
         for (auto it = vec_begin; it != vec_end; it++) {
+            LIBHAT_RECORD_STATS(context, stats.vectors++);
+            if (context.adaptive) {
+                if (const auto sample = monitor.exceeded(it); !sample.empty()) LIBHAT_UNLIKELY {
+                    // The anchor matches too often in this region, continue from here with a better one
+                    const auto next = context.reanchored(sample);
+                    LIBHAT_RECORD_STATS(context, stats.reanchored = true);
+                    const auto resume = reinterpret_cast<const std::byte*>(it) - cmpIndex;
+                    return next.pairIndex
+                        ? find_pattern_neon<alignment, true, veccmp>(resume, end, next)
+                        : find_pattern_neon<alignment, false, veccmp>(resume, end, next);
+                }
+            }
+
             auto cmp = vceqq_u8(firstByte, vld1q_u8(reinterpret_cast<const std::uint8_t*>(it)));
 
             if constexpr (cmpeq2) {
@@ -92,9 +108,13 @@ namespace hat::detail {
                 mask &= std::rotl(create_alignment_mask_neon<alignment>(), static_cast<int>(cmpIndex) * 4);
             }
 
+            if (context.adaptive) {
+                monitor.add(std::popcount(mask) / 4);
+            }
             while (mask) {
                 const auto offset = LIBHAT_BSF64(mask);
                 const auto i = reinterpret_cast<const std::byte*>(it) + (offset >> 2) - cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
                 if constexpr (veccmp) {
                     const auto data = vld1q_u8(reinterpret_cast<const std::uint8_t*>(i));
                     const auto neqBits = veorq_u8(data, signatureBytes);
@@ -103,7 +123,7 @@ namespace hat::detail {
                         return i;
                     }
                 } else {
-                    const auto match = std::equal(signature.begin(), signature.end(), i);
+                    const auto match = verify_packed(context, i);
                     if (match) LIBHAT_UNLIKELY {
                         return i;
                     }
@@ -120,6 +140,26 @@ namespace hat::detail {
         return {};
     }
 
+    std::size_t count_mismatches_neon(const std::byte* data, const signature_view signature, const std::size_t limit) {
+        static_assert(sizeof(signature_element) == 2);
+        const auto elements = reinterpret_cast<const std::uint8_t*>(signature.data());
+
+        std::size_t mismatches{};
+        std::size_t i = 0;
+        for (; i + 16 <= signature.size(); i += 16) {
+            // De-interleaves the value and mask of each element
+            const auto sig = vld2q_u8(elements + i * 2);
+            const auto value = vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i));
+            const auto neqBits = vandq_u8(veorq_u8(value, sig.val[0]), sig.val[1]);
+            const auto mismatch = vshrq_n_u8(vtstq_u8(neqBits, neqBits), 7);
+            mismatches += static_cast<std::size_t>(LIBHAT_SUM_U8(mismatch));
+            if (mismatches > limit) {
+                return mismatches;
+            }
+        }
+        return mismatches + count_mismatches_single(data + i, signature.subspan(i), limit - mismatches);
+    }
+
     template<>
     scan_function_t resolve_scanner<scan_mode::Neon>(scan_context& context) {
         context.apply_hints({.vectorSize = 16});
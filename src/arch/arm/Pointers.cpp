@@ -0,0 +1,58 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_AARCH64)
+
+#include "../../Pointers.hpp"
+
+#include <arm_neon.h>
+
+namespace hat::detail {
+
+    /// Appends the lanes of 4 words which are set, if there are any
+    LIBHAT_FORCEINLINE static void append_candidates(const uint64x2_t low, const uint64x2_t high, const std::size_t index, std::vector<std::size_t>& out) {
+        if (vmaxvq_u32(vreinterpretq_u32_u64(vorrq_u64(low, high))) == 0) {
+            return;
+        }
+        std::uint64_t lanes[4];
+        vst1q_u64(lanes, low);
+        vst1q_u64(lanes + 2, high);
+        for (std::size_t lane = 0; lane < 4; lane++) {
+            if (lanes[lane]) {
+                out.push_back(index + lane);
+            }
+        }
+    }
+
+    std::size_t find_pointers_range_neon(const std::byte* words, const std::size_t count, const pointer_range_filter filter, std::vector<std::size_t>& out) {
+        const auto low = vdupq_n_u64(filter.low);
+        const auto span = vdupq_n_u64(filter.span);
+        const auto* const values = reinterpret_cast<const std::uint64_t*>(words);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto a = vcleq_u64(vsubq_u64(vld1q_u64(values + i), low), span);
+            const auto b = vcleq_u64(vsubq_u64(vld1q_u64(values + i + 2), low), span);
+            append_candidates(a, b, i, out);
+        }
+        return i;
+    }
+
+    std::size_t find_pointers_values_neon(const std::byte* words, const std::size_t count, const pointer_values_filter& targets, std::vector<std::size_t>& out) {
+        static_assert(pointer_filter_values == 4);
+        const auto v0 = vdupq_n_u64(targets[0]);
+        const auto v1 = vdupq_n_u64(targets[1]);
+        const auto v2 = vdupq_n_u64(targets[2]);
+        const auto v3 = vdupq_n_u64(targets[3]);
+        const auto equal = [&](const uint64x2_t data) {
+            return vorrq_u64(vorrq_u64(vceqq_u64(data, v0), vceqq_u64(data, v1)), vorrq_u64(vceqq_u64(data, v2), vceqq_u64(data, v3)));
+        };
+        const auto* const values = reinterpret_cast<const std::uint64_t*>(words);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            append_candidates(equal(vld1q_u64(values + i)), equal(vld1q_u64(values + i + 2)), i, out);
+        }
+        return i;
+    }
+}
+#endif
@@ -0,0 +1,53 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+
+#include "../../Xrefs.hpp"
+
+#include <arm_neon.h>
+
+namespace hat::detail {
+
+    std::size_t find_xref_candidates_aarch64_neon(const std::byte* data, const std::size_t count, const std::uint32_t pc, const xref_filter_aarch64& filter, std::vector<std::size_t>& out) {
+        const auto branchOpcode = vdupq_n_u32(filter.branchOpcode);
+        const auto branchBias = vdupq_n_u32(filter.branchBias);
+        const auto branchLimit = vdupq_n_u32(filter.branchLimit);
+        const auto adrpOpcode = vdupq_n_u32(filter.adrpOpcode);
+        const auto pageBias = vdupq_n_u32(filter.pageBias);
+        const auto pageLimit = vdupq_n_u32(filter.pageLimit);
+        static constexpr std::uint32_t laneOffsets[4]{0, 4, 8, 12};
+        auto pcs = vaddq_u32(vdupq_n_u32(pc), vld1q_u32(laneOffsets));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto words = vreinterpretq_u32_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i * 4)));
+
+            const auto isBranch = vceqq_u32(vandq_u32(words, vdupq_n_u32(0x7C000000)), branchOpcode);
+            const auto offset = vaddq_u32(vshlq_n_u32(words, 6), vshlq_n_u32(vsubq_u32(pcs, branchBias), 4));
+            const auto branch = vandq_u32(isBranch, vcleq_u32(offset, branchLimit));
+
+            const auto isAdrp = vceqq_u32(vandq_u32(words, vdupq_n_u32(0x9F000000)), adrpOpcode);
+            const auto immediate = vorrq_u32(
+                vandq_u32(vshlq_n_u32(words, 9), vdupq_n_u32(0xFFFFC000)),
+                vandq_u32(vshrq_n_u32(words, 17), vdupq_n_u32(0x3000)));
+            const auto page = vsubq_u32(vaddq_u32(immediate, vandq_u32(pcs, vdupq_n_u32(~0xFFFu))), pageBias);
+            const auto adrp = vandq_u32(isAdrp, vcleq_u32(page, pageLimit));
+
+            // Candidates are rare, so the lanes are only extracted when there is one
+            const auto candidates = vorrq_u32(branch, adrp);
+            const auto halves = vorr_u32(vget_low_u32(candidates), vget_high_u32(candidates));
+            if (vget_lane_u32(vpmax_u32(halves, halves), 0)) {
+                std::uint32_t lanes[4];
+                vst1q_u32(lanes, candidates);
+                for (std::size_t lane = 0; lane < 4; lane++) {
+                    if (lanes[lane]) {
+                        out.push_back(i + lane);
+                    }
+                }
+            }
+            pcs = vaddq_u32(pcs, vdupq_n_u32(16));
+        }
+        return i;
+    }
+}
+#endif
@@ -11,15 +11,9 @@
 namespace hat::detail {
 
     LIBHAT_TARGET("avx")
-    static void load_signature_256(const signature_view signature, __m256i& bytes, __m256i& mask) {
-        std::byte byteBuffer[32]{}; // The remaining signature bytes
-        std::byte maskBuffer[32]{}; // A bitmask for the signature bytes we care about
-        for (std::size_t i = 0; i < signature.size(); i++) {
-            byteBuffer[i] = signature[i].value();
-            maskBuffer[i] = signature[i].mask();
-        }
-        bytes = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&byteBuffer));
-        mask = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&maskBuffer));
+    static void load_signature_256(const packed_signature& packed, __m256i& bytes, __m256i& mask) {
+        bytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(packed.values.data()));
+        mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(packed.masks.data()));
     }
 
     template<scan_alignment alignment, bool cmpeq2, bool veccmp>
@@ -28,6 +22,11 @@ namespace hat::detail {
         const auto signature = context.signature;
         const auto cmpIndex = cmpeq2 ? *context.pairIndex : context.cmpIndex;
 
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "AVX2";
+            stats.anchor_index = cmpIndex;
+            stats.pair_index = cmpeq2 ? context.pairIndex : std::nullopt);
+
         // 256 bit vector containing first signature byte repeated
         const auto firstByte = _mm256_set1_epi8(static_cast<std::int8_t>(*signature[cmpIndex]));
 
@@ -38,7 +37,7 @@ namespace hat::detail {
 
         __m256i signatureBytes, signatureMask;
         if constexpr (veccmp) {
-            load_signature_256(signature, signatureBytes, signatureMask);
+            load_signature_256(context.packed, signatureBytes, signatureMask);
         }
 
         auto [pre, vec, post] = segment_scan<__m256i, 32, veccmp>(begin, end, signature.size(), cmpIndex);
@@ -52,7 +51,21 @@ namespace hat::detail {
 
         const auto vec_begin = std::to_address(vec.begin());
         const auto vec_end = std::to_address(vec.end());
+        anchor_monitor monitor{vec_begin};
         for (auto it = vec_begin; it != vec_end; it++) {
+            LIBHAT_RECORD_STATS(context, stats.vectors++);
+            if (context.adaptive) {
+                if (const auto sample = monitor.exceeded(it); !sample.empty()) LIBHAT_UNLIKELY {
+                    // The anchor matches too often in this region, continue from here with a better one
+                    const auto next = context.reanchored(sample);
+                    LIBHAT_RECORD_STATS(context, stats.reanchored = true);
+                    const auto resume = reinterpret_cast<const std::byte*>(it) - cmpIndex;
+                    return next.pairIndex
+                        ? find_pattern_avx2<alignment, true, veccmp>(resume, end, next)
+                        : find_pattern_avx2<alignment, false, veccmp>(resume, end, next);
+                }
+            }
+
             const auto cmp = _mm256_cmpeq_epi8(firstByte, _mm256_load_si256(it));
             auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(cmp));
 
@@ -69,9 +82,13 @@ namespace hat::detail {
                 if (!mask) continue;
             }
 
+            if (context.adaptive) {
+                monitor.add(std::popcount(mask));
+            }
             while (mask) {
                 const auto offset = _tzcnt_u32(mask);
                 const auto i = reinterpret_cast<const std::byte*>(it) + offset - cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
                 if constexpr (veccmp) {
                     const auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
                     const auto neqBits = _mm256_xor_si256(data, signatureBytes);
@@ -80,7 +97,7 @@ namespace hat::detail {
                         return i;
                     }
                 } else {
-                    const auto match = std::equal(signature.begin(), signature.end(), i);
+                    const auto match = verify_packed(context, i);
                     if (match) LIBHAT_UNLIKELY {
                         return i;
                     }
@@ -95,6 +112,35 @@ namespace hat::detail {
         return {};
     }
 
+    LIBHAT_TARGET("avx,avx2,popcnt")
+    std::size_t count_mismatches_avx2(const std::byte* data, const signature_view signature, const std::size_t limit) {
+        static_assert(sizeof(signature_element) == 2);
+        const auto elements = reinterpret_cast<const std::byte*>(signature.data());
+        const auto lowBytes = _mm256_set1_epi16(0x00FF);
+
+        std::size_t mismatches{};
+        std::size_t i = 0;
+        for (; i + 32 <= signature.size(); i += 32) {
+            const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elements + i * 2));
+            const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elements + i * 2 + 32));
+
+            // De-interleave the value and mask of each element, packing works per 128-bit lane so fix the order after
+            const auto signatureBytes = _mm256_permute4x64_epi64(
+                _mm256_packus_epi16(_mm256_and_si256(lo, lowBytes), _mm256_and_si256(hi, lowBytes)), 0b11'01'10'00);
+            const auto signatureMask = _mm256_permute4x64_epi64(
+                _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8)), 0b11'01'10'00);
+
+            const auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const auto neqBits = _mm256_and_si256(_mm256_xor_si256(value, signatureBytes), signatureMask);
+            const auto eq = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(neqBits, _mm256_setzero_si256())));
+            mismatches += static_cast<std::size_t>(std::popcount(~eq));
+            if (mismatches > limit) {
+                return mismatches;
+            }
+        }
+        return mismatches + count_mismatches_single(data + i, signature.subspan(i), limit - mismatches);
+    }
+
     template<>
     scan_function_t resolve_scanner<scan_mode::AVX2>(scan_context& context) {
         context.apply_hints({.vectorSize = 32});
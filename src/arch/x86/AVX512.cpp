@@ -11,15 +11,9 @@
 namespace hat::detail {
 
     LIBHAT_TARGET("avx512f")
-    static void load_signature_512(const signature_view signature, __m512i& bytes, __m512i& mask) {
-        alignas(64) std::byte byteBuffer[64]{}; // The remaining signature bytes
-        alignas(64) std::byte maskBuffer[64]{}; // A bitmask for the signature bytes we care about
-        for (std::size_t i = 0; i < signature.size(); i++) {
-            byteBuffer[i] = signature[i].value();
-            maskBuffer[i] = signature[i].mask();
-        }
-        bytes = _mm512_loadu_si512(&byteBuffer);
-        mask = _mm512_loadu_si512(&maskBuffer);
+    static void load_signature_512(const packed_signature& packed, __m512i& bytes, __m512i& mask) {
+        bytes = _mm512_load_si512(packed.values.data());
+        mask = _mm512_load_si512(packed.masks.data());
     }
 
     template<scan_alignment alignment, bool cmpeq2, bool veccmp>
@@ -28,6 +22,11 @@ namespace hat::detail {
         const auto signature = context.signature;
         const auto cmpIndex = cmpeq2 ? *context.pairIndex : context.cmpIndex;
 
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "AVX512";
+            stats.anchor_index = cmpIndex;
+            stats.pair_index = cmpeq2 ? context.pairIndex : std::nullopt);
+
         // 512 bit vector containing first signature byte repeated
         const auto firstByte = _mm512_set1_epi8(static_cast<std::int8_t>(*signature[cmpIndex]));
 
@@ -39,7 +38,7 @@ namespace hat::detail {
         __m512i signatureBytes;
         __m512i signatureMask;
         if constexpr (veccmp) {
-            load_signature_512(signature, signatureBytes, signatureMask);
+            load_signature_512(context.packed, signatureBytes, signatureMask);
         }
 
         auto [pre, vec, post] = segment_scan<__m512i, 64, veccmp>(begin, end, signature.size(), cmpIndex);
@@ -53,7 +52,21 @@ namespace hat::detail {
 
         const auto vec_begin = std::to_address(vec.begin());
         const auto vec_end = std::to_address(vec.end());
+        anchor_monitor monitor{vec_begin};
         for (auto it = vec_begin; it != vec_end; it++) {
+            LIBHAT_RECORD_STATS(context, stats.vectors++);
+            if (context.adaptive) {
+                if (const auto sample = monitor.exceeded(it); !sample.empty()) LIBHAT_UNLIKELY {
+                    // The anchor matches too often in this region, continue from here with a better one
+                    const auto next = context.reanchored(sample);
+                    LIBHAT_RECORD_STATS(context, stats.reanchored = true);
+                    const auto resume = reinterpret_cast<const std::byte*>(it) - cmpIndex;
+                    return next.pairIndex
+                        ? find_pattern_avx512<alignment, true, veccmp>(resume, end, next)
+                        : find_pattern_avx512<alignment, false, veccmp>(resume, end, next);
+                }
+            }
+
             auto mask = _mm512_cmpeq_epi8_mask(firstByte, _mm512_load_si512(it));
 
             if constexpr (cmpeq2) {
@@ -66,9 +79,13 @@ namespace hat::detail {
                 if (!mask) continue;
             }
 
+            if (context.adaptive) {
+                monitor.add(std::popcount(mask));
+            }
             while (mask) {
                 const auto offset = _tzcnt_u64(mask);
                 const auto i = reinterpret_cast<const std::byte*>(it) + offset - cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
                 if constexpr (veccmp) {
                     const auto data = _mm512_loadu_si512(i);
                     const auto neqBits = _mm512_xor_si512(data, signatureBytes);
@@ -77,7 +94,7 @@ namespace hat::detail {
                         return i;
                     }
                 } else {
-                    const auto match = std::equal(signature.begin(), signature.end(), i);
+                    const auto match = verify_packed(context, i);
                     if (match) LIBHAT_UNLIKELY {
                         return i;
                     }
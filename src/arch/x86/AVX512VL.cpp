@@ -0,0 +1,175 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_X86_64) && defined(LIBHAT_FEATURE_AVX512)
+
+#include <libhat/scanner.hpp>
+
+#include "../../Utils.hpp"
+
+#include <immintrin.h>
+
+namespace hat::detail {
+
+    LIBHAT_TARGET("avx")
+    static void load_signature_256(const packed_signature& packed, __m256i& bytes, __m256i& mask) {
+        bytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(packed.values.data()));
+        mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(packed.masks.data()));
+    }
+
+    /// Picks a third anchor for the scanner, the fully masked byte furthest from the primary anchor(s) that still
+    /// fits in the vector following the current one. Returns its distance from the primary anchor, or 0 if none.
+    static std::size_t find_far_anchor(const scan_context& context, const std::size_t cmpIndex, const bool cmpeq2) {
+        const auto first = cmpIndex + (cmpeq2 ? 2 : 1);
+        const auto last = std::min(context.signature.size(), cmpIndex + 32);
+        if (last <= context.packed.size) {
+            // Every candidate is packed, so the furthest one is the highest bit of the fully masked bitmap in range
+            const auto candidates = first < last
+                ? (context.packed.known >> first) & (~std::uint64_t{0} >> (64 - (last - first)))
+                : 0;
+            return candidates ? first + static_cast<std::size_t>(63 - std::countl_zero(candidates)) - cmpIndex : 0;
+        }
+        for (auto i = last; i > first; i--) {
+            if (context.signature[i - 1].all()) {
+                return i - 1 - cmpIndex;
+            }
+        }
+        return 0;
+    }
+
+    /// Byte indices into the concatenation of two vectors which shift it down by "distance" bytes
+    LIBHAT_TARGET("avx")
+    static __m256i create_shift_indices(const std::size_t distance) {
+        alignas(32) std::uint8_t indices[32];
+        for (std::size_t i = 0; i < 32; i++) {
+            indices[i] = static_cast<std::uint8_t>(i + distance);
+        }
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(&indices));
+    }
+
+    template<scan_alignment alignment, bool cmpeq2, bool veccmp>
+    LIBHAT_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,bmi")
+    static const_scan_result find_pattern_avx512vl(const std::byte* begin, const std::byte* end, const scan_context& context) {
+        const auto signature = context.signature;
+        const auto cmpIndex = cmpeq2 ? *context.pairIndex : context.cmpIndex;
+        const auto farDistance = find_far_anchor(context, cmpIndex, cmpeq2);
+
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "AVX512VL";
+            stats.anchor_index = cmpIndex;
+            stats.pair_index = cmpeq2 ? context.pairIndex : std::nullopt);
+
+        // 256 bit vector containing first signature byte repeated
+        const auto firstByte = _mm256_set1_epi8(static_cast<std::int8_t>(*signature[cmpIndex]));
+
+        __m256i secondByte;
+        if constexpr (cmpeq2) {
+            secondByte = _mm256_set1_epi8(static_cast<std::int8_t>(*signature[cmpIndex + 1]));
+        }
+
+        // The far anchor is gathered from the current and next vector with vpermb, instead of a load that would
+        // usually cross a cache line
+        const bool far = farDistance != 0;
+        __m256i farByte{}, farIndices{};
+        if (far) {
+            farByte = _mm256_set1_epi8(static_cast<std::int8_t>(*signature[cmpIndex + farDistance]));
+            farIndices = create_shift_indices(farDistance);
+        }
+
+        __m256i signatureBytes, signatureMask;
+        if constexpr (veccmp) {
+            load_signature_256(context.packed, signatureBytes, signatureMask);
+        }
+
+        // The vectorized part always leaves at least one vector of readable data after the last one it scans
+        auto [pre, vec, post] = segment_scan<__m256i, 32, veccmp>(begin, end, signature.size(), cmpIndex);
+
+        if (!pre.empty()) {
+            const auto result = find_pattern_single<alignment>(pre.data(), pre.data() + pre.size(), context);
+            if (result.has_result()) {
+                return result;
+            }
+        }
+
+        const auto vec_begin = std::to_address(vec.begin());
+        const auto vec_end = std::to_address(vec.end());
+        anchor_monitor monitor{vec_begin};
+        for (auto it = vec_begin; it != vec_end; it++) {
+            LIBHAT_RECORD_STATS(context, stats.vectors++);
+            if (context.adaptive) {
+                if (const auto sample = monitor.exceeded(it); !sample.empty()) LIBHAT_UNLIKELY {
+                    // The anchor matches too often in this region, continue from here with a better one
+                    const auto next = context.reanchored(sample);
+                    LIBHAT_RECORD_STATS(context, stats.reanchored = true);
+                    const auto resume = reinterpret_cast<const std::byte*>(it) - cmpIndex;
+                    return next.pairIndex
+                        ? find_pattern_avx512vl<alignment, true, veccmp>(resume, end, next)
+                        : find_pattern_avx512vl<alignment, false, veccmp>(resume, end, next);
+                }
+            }
+
+            const auto current = _mm256_load_si256(it);
+            auto mask = _mm256_cmpeq_epi8_mask(firstByte, current);
+            if (!mask) LIBHAT_LIKELY {
+                continue;
+            }
+
+            // Unlike the AVX2 and AVX512 scanners, the anchors after the first are only compared where the ones
+            // before them matched, and exactly so in the last lane
+            if constexpr (cmpeq2) {
+                const auto shifted = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(reinterpret_cast<const std::byte*>(it) + 1));
+                mask = _mm256_mask_cmpeq_epi8_mask(mask, secondByte, shifted);
+            }
+            if (far) {
+                const auto shifted = _mm256_permutex2var_epi8(current, farIndices, _mm256_load_si256(it + 1));
+                mask = _mm256_mask_cmpeq_epi8_mask(mask, farByte, shifted);
+            }
+
+            if constexpr (alignment != scan_alignment::X1) {
+                mask &= std::rotl(create_alignment_mask<std::uint32_t, alignment>(), static_cast<int>(cmpIndex));
+            }
+
+            if (context.adaptive) {
+                monitor.add(std::popcount(mask));
+            }
+            while (mask) {
+                const auto offset = _tzcnt_u32(mask);
+                const auto i = reinterpret_cast<const std::byte*>(it) + offset - cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
+                if constexpr (veccmp) {
+                    const auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
+                    const auto neqBits = _mm256_xor_si256(data, signatureBytes);
+                    const auto invalid = _mm256_test_epi64_mask(neqBits, signatureMask);
+                    if (!invalid) LIBHAT_UNLIKELY {
+                        return i;
+                    }
+                } else {
+                    const auto match = verify_packed(context, i);
+                    if (match) LIBHAT_UNLIKELY {
+                        return i;
+                    }
+                }
+                mask = _blsr_u32(mask);
+            }
+        }
+
+        if (!post.empty()) {
+            return find_pattern_single<alignment>(post.data(), post.data() + post.size(), context);
+        }
+        return {};
+    }
+
+    template<>
+    scan_function_t resolve_scanner<scan_mode::AVX512VL>(scan_context& context) {
+        context.apply_hints({.vectorSize = 32});
+
+        const auto alignment = context.alignment;
+        const auto signature = context.signature;
+        const bool cmpeq2 = context.pairIndex.has_value();
+        const bool veccmp = signature.size() <= 32;
+
+        return find_specialization_switch<[]<auto... p>() consteval {
+            return &find_pattern_avx512vl<p...>;
+        }>(alignment, cmpeq2, veccmp);
+    }
+}
+#endif
@@ -0,0 +1,59 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+
+#include "../../Hash.hpp"
+
+#include <cstring>
+
+#include <nmmintrin.h>
+
+namespace hat::detail {
+
+#ifdef LIBHAT_X86_64
+    using crc32c_word_t = std::uint64_t;
+
+    LIBHAT_TARGET("sse4.2")
+    LIBHAT_FORCEINLINE static std::uint32_t crc32c_word(const std::uint32_t crc, const std::byte* data) {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return static_cast<std::uint32_t>(_mm_crc32_u64(crc, word));
+    }
+#else
+    using crc32c_word_t = std::uint32_t;
+
+    LIBHAT_TARGET("sse4.2")
+    LIBHAT_FORCEINLINE static std::uint32_t crc32c_word(const std::uint32_t crc, const std::byte* data) {
+        std::uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return _mm_crc32_u32(crc, word);
+    }
+#endif
+
+    LIBHAT_TARGET("sse4.2")
+    std::uint32_t crc32c_sse42(std::uint32_t crc, const std::byte* data, std::size_t size) {
+        // The crc32 instruction has a latency of 3 cycles but a throughput of 1, so three independent streams are
+        // computed at once and joined afterwards
+        constexpr auto stream = crc32c_stream_size;
+        while (size >= stream * 3) {
+            std::uint32_t crc1{}, crc2{};
+            for (std::size_t i = 0; i < stream; i += sizeof(crc32c_word_t)) {
+                crc = crc32c_word(crc, data + i);
+                crc1 = crc32c_word(crc1, data + stream + i);
+                crc2 = crc32c_word(crc2, data + stream * 2 + i);
+            }
+            crc = crc32c_shift(crc32c_shift(crc) ^ crc1) ^ crc2;
+            data += stream * 3;
+            size -= stream * 3;
+        }
+
+        for (; size >= sizeof(crc32c_word_t); data += sizeof(crc32c_word_t), size -= sizeof(crc32c_word_t)) {
+            crc = crc32c_word(crc, data);
+        }
+        for (; size; data++, size--) {
+            crc = _mm_crc32_u8(crc, std::to_integer<std::uint8_t>(*data));
+        }
+        return crc;
+    }
+}
+#endif
@@ -0,0 +1,98 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_X86_64)
+
+#include "../../Pointers.hpp"
+
+#include <bit>
+#include <limits>
+
+#include <immintrin.h>
+
+namespace hat::detail {
+
+    LIBHAT_FORCEINLINE static void append_candidates(std::uint64_t mask, const std::size_t index, std::vector<std::size_t>& out) {
+        for (; mask; mask &= mask - 1) {
+            out.push_back(index + static_cast<std::size_t>(std::countr_zero(mask)));
+        }
+    }
+
+    /// The lanes of 4 words which are above the range, as bits
+    LIBHAT_TARGET("avx,avx2")
+    LIBHAT_FORCEINLINE static std::uint32_t above_range(const std::byte* words, const __m256i low, const __m256i span, const __m256i sign) {
+        const auto values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+        const auto offset = _mm256_xor_si256(_mm256_sub_epi64(values, low), sign);
+        return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(offset, span))));
+    }
+
+    LIBHAT_TARGET("avx,avx2")
+    std::size_t find_pointers_range_avx2(const std::byte* words, const std::size_t count, const pointer_range_filter filter, std::vector<std::size_t>& out) {
+        // There is no unsigned 64-bit comparison, flipping the sign bits makes the signed one order them the same way
+        const auto sign = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min());
+        const auto low = _mm256_set1_epi64x(static_cast<std::int64_t>(filter.low));
+        const auto span = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<std::int64_t>(filter.span)), sign);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto above = above_range(words + i * 8, low, span, sign) | (above_range(words + i * 8 + 32, low, span, sign) << 4);
+            append_candidates(~above & 0xFF, i, out);
+        }
+        return i;
+    }
+
+    LIBHAT_TARGET("avx,avx2")
+    std::size_t find_pointers_values_avx2(const std::byte* words, const std::size_t count, const pointer_values_filter& values, std::vector<std::size_t>& out) {
+        static_assert(pointer_filter_values == 4);
+        const auto v0 = _mm256_set1_epi64x(static_cast<std::int64_t>(values[0]));
+        const auto v1 = _mm256_set1_epi64x(static_cast<std::int64_t>(values[1]));
+        const auto v2 = _mm256_set1_epi64x(static_cast<std::int64_t>(values[2]));
+        const auto v3 = _mm256_set1_epi64x(static_cast<std::int64_t>(values[3]));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i * 8));
+            const auto equal = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi64(data, v0), _mm256_cmpeq_epi64(data, v1)),
+                _mm256_or_si256(_mm256_cmpeq_epi64(data, v2), _mm256_cmpeq_epi64(data, v3)));
+            append_candidates(static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))), i, out);
+        }
+        return i;
+    }
+
+#if defined(LIBHAT_FEATURE_AVX512)
+    LIBHAT_TARGET("avx512f")
+    std::size_t find_pointers_range_avx512(const std::byte* words, const std::size_t count, const pointer_range_filter filter, std::vector<std::size_t>& out) {
+        const auto low = _mm512_set1_epi64(static_cast<std::int64_t>(filter.low));
+        const auto span = _mm512_set1_epi64(static_cast<std::int64_t>(filter.span));
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const auto a = _mm512_loadu_si512(words + i * 8);
+            const auto b = _mm512_loadu_si512(words + i * 8 + 64);
+            const auto maskA = _mm512_cmple_epu64_mask(_mm512_sub_epi64(a, low), span);
+            const auto maskB = _mm512_cmple_epu64_mask(_mm512_sub_epi64(b, low), span);
+            append_candidates(static_cast<std::uint64_t>(maskA) | (static_cast<std::uint64_t>(maskB) << 8), i, out);
+        }
+        return i;
+    }
+
+    LIBHAT_TARGET("avx512f")
+    std::size_t find_pointers_values_avx512(const std::byte* words, const std::size_t count, const pointer_values_filter& values, std::vector<std::size_t>& out) {
+        static_assert(pointer_filter_values == 4);
+        const auto v0 = _mm512_set1_epi64(static_cast<std::int64_t>(values[0]));
+        const auto v1 = _mm512_set1_epi64(static_cast<std::int64_t>(values[1]));
+        const auto v2 = _mm512_set1_epi64(static_cast<std::int64_t>(values[2]));
+        const auto v3 = _mm512_set1_epi64(static_cast<std::int64_t>(values[3]));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const auto data = _mm512_loadu_si512(words + i * 8);
+            const auto mask = _mm512_cmpeq_epu64_mask(data, v0) | _mm512_cmpeq_epu64_mask(data, v1)
+                | _mm512_cmpeq_epu64_mask(data, v2) | _mm512_cmpeq_epu64_mask(data, v3);
+            append_candidates(static_cast<std::uint64_t>(mask), i, out);
+        }
+        return i;
+    }
+#endif
+}
+#endif
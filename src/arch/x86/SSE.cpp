@@ -24,15 +24,9 @@
 
 namespace hat::detail {
 
-    static void load_signature_128(const signature_view signature, __m128i& bytes, __m128i& mask) {
-        std::byte byteBuffer[16]{}; // The remaining signature bytes
-        std::byte maskBuffer[16]{}; // A bitmask for the signature bytes we care about
-        for (std::size_t i = 0; i < signature.size(); i++) {
-            byteBuffer[i] = signature[i].value();
-            maskBuffer[i] = signature[i].mask();
-        }
-        bytes = _mm_loadu_si128(reinterpret_cast<__m128i*>(&byteBuffer));
-        mask = _mm_loadu_si128(reinterpret_cast<__m128i*>(&maskBuffer));
+    static void load_signature_128(const packed_signature& packed, __m128i& bytes, __m128i& mask) {
+        bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(packed.values.data()));
+        mask = _mm_load_si128(reinterpret_cast<const __m128i*>(packed.masks.data()));
     }
 
     template<scan_alignment alignment, bool cmpeq2, bool veccmp>
@@ -41,6 +35,11 @@ namespace hat::detail {
         const auto signature = context.signature;
         const auto cmpIndex = cmpeq2 ? *context.pairIndex : context.cmpIndex;
 
+        LIBHAT_RECORD_STATS(context,
+            stats.kernel = "SSE";
+            stats.anchor_index = cmpIndex;
+            stats.pair_index = cmpeq2 ? context.pairIndex : std::nullopt);
+
         // 128 bit vector containing first signature byte repeated
         const auto firstByte = _mm_set1_epi8(static_cast<std::int8_t>(*signature[cmpIndex]));
 
@@ -51,7 +50,7 @@ namespace hat::detail {
 
         __m128i signatureBytes, signatureMask;
         if constexpr (veccmp) {
-            load_signature_128(signature, signatureBytes, signatureMask);
+            load_signature_128(context.packed, signatureBytes, signatureMask);
         }
 
         auto [pre, vec, post] = segment_scan<__m128i, 16, veccmp>(begin, end, signature.size(), cmpIndex);
@@ -65,7 +64,21 @@ namespace hat::detail {
 
         const auto vec_begin = std::to_address(vec.begin());
         const auto vec_end = std::to_address(vec.end());
+        anchor_monitor monitor{vec_begin};
         for (auto it = vec_begin; it != vec_end; it++) {
+            LIBHAT_RECORD_STATS(context, stats.vectors++);
+            if (context.adaptive) {
+                if (const auto sample = monitor.exceeded(it); !sample.empty()) LIBHAT_UNLIKELY {
+                    // The anchor matches too often in this region, continue from here with a better one
+                    const auto next = context.reanchored(sample);
+                    LIBHAT_RECORD_STATS(context, stats.reanchored = true);
+                    const auto resume = reinterpret_cast<const std::byte*>(it) - cmpIndex;
+                    return next.pairIndex
+                        ? find_pattern_sse<alignment, true, veccmp>(resume, end, next)
+                        : find_pattern_sse<alignment, false, veccmp>(resume, end, next);
+                }
+            }
+
             const auto cmp = _mm_cmpeq_epi8(firstByte, _mm_load_si128(it));
             auto mask = static_cast<std::uint16_t>(_mm_movemask_epi8(cmp));
 
@@ -79,9 +92,13 @@ namespace hat::detail {
                 mask &= std::rotl(create_alignment_mask<std::uint16_t, alignment>(), static_cast<int>(cmpIndex));
             }
 
+            if (context.adaptive) {
+                monitor.add(std::popcount(mask));
+            }
             while (mask) {
                 const auto offset = LIBHAT_BSF32(mask);
                 const auto i = reinterpret_cast<const std::byte*>(it) + offset - cmpIndex;
+                LIBHAT_RECORD_STATS(context, stats.candidates++);
                 if constexpr (veccmp) {
                     const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
                     const auto neqBits = _mm_xor_si128(data, signatureBytes);
@@ -90,7 +107,7 @@ namespace hat::detail {
                         return i;
                     }
                 } else {
-                    const auto match = std::equal(signature.begin(), signature.end(), i);
+                    const auto match = verify_packed(context, i);
                     if (match) LIBHAT_UNLIKELY {
                         return i;
                     }
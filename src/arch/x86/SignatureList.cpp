@@ -0,0 +1,50 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+
+#include "../../SignatureList.hpp"
+
+#include <tmmintrin.h>
+
+namespace hat::detail {
+
+    LIBHAT_TARGET("ssse3")
+    LIBHAT_FORCEINLINE static std::uint64_t any_class(const __m128i classes, const std::uint8_t flags) {
+        const auto none = _mm_cmpeq_epi8(_mm_and_si128(classes, _mm_set1_epi8(static_cast<char>(flags))), _mm_setzero_si128());
+        return static_cast<std::uint16_t>(~_mm_movemask_epi8(none));
+    }
+
+    LIBHAT_TARGET("ssse3")
+    void classify_signature_text_ssse3(const char* text, const std::size_t blocks, signature_text_block* out, std::uint8_t* nibbles) {
+        const auto lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signature_char_low_nibble.data()));
+        const auto highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signature_char_high_nibble.data()));
+        const auto lowBits = _mm_set1_epi8(0x0F);
+        const auto letter = _mm_set1_epi8(char_letter);
+
+        for (std::size_t block = 0; block < blocks; block++) {
+            signature_text_block bits{};
+            for (std::size_t i = 0; i < signature_text_block_size; i += 16) {
+                const auto offset = block * signature_text_block_size + i;
+                const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + offset));
+                const auto low = _mm_and_si128(chars, lowBits);
+                const auto high = _mm_and_si128(_mm_srli_epi16(chars, 4), lowBits);
+                const auto classes = _mm_and_si128(_mm_shuffle_epi8(lowTable, low), _mm_shuffle_epi8(highTable, high));
+
+                bits.hex |= any_class(classes, char_digit | char_letter) << i;
+                bits.wildcard |= any_class(classes, char_wildcard) << i;
+                bits.newline |= any_class(classes, char_newline) << i;
+                bits.cr |= any_class(classes, char_cr) << i;
+                bits.other |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(classes, _mm_setzero_si128())))) << i;
+
+                // The value of a letter is its low nibble plus 9, such as 1 + 9 for A (0x41)
+                const auto isLetter = _mm_cmpeq_epi8(_mm_and_si128(classes, letter), letter);
+                const auto values = _mm_add_epi8(low, _mm_and_si128(isLetter, _mm_set1_epi8(9)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(nibbles + offset), values);
+            }
+            out[block] = bits;
+        }
+    }
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <vector>
 #include <cstring>
+#include <string_view>
 
 #include <immintrin.h>
 
@@ -66,6 +67,8 @@ namespace hat {
     static constexpr int CPU_BASIC_INFO = 0;
     static constexpr int CPU_EXTENDED_INFO = static_cast<int>(0x80000000);
     static constexpr int CPU_BRAND_STRING = static_cast<int>(0x80000004);
+    static constexpr int CPU_INTEL_CACHE_INFO = 4;
+    static constexpr int CPU_AMD_CACHE_INFO = static_cast<int>(0x8000001D);
 
     system_info_x86::system_info_x86() {
         // Gather basic info
@@ -85,6 +88,7 @@ namespace hat {
         const std::bitset<32> f_1_ECX_{static_cast<std::uint32_t>(data[1].ecx)};
         const std::bitset<32> f_1_EDX_{static_cast<std::uint32_t>(data[1].edx)};
         const std::bitset<32> f_7_EBX_{static_cast<std::uint32_t>(data[7].ebx)};
+        const std::bitset<32> f_7_ECX_{static_cast<std::uint32_t>(data[7].ecx)};
 
         // Gather extended info
         std::array<info_t, 5> extData{};
@@ -117,19 +121,54 @@ namespace hat {
         this->cpu_vendor = vendor;
         this->cpu_brand = brand;
         this->extensions = {
-            .sse      = f_1_EDX_[25],
-            .sse2     = f_1_EDX_[26],
-            .sse3     = f_1_ECX_[0],
-            .ssse3    = f_1_ECX_[9],
-            .sse41    = f_1_ECX_[19],
-            .sse42    = f_1_ECX_[20],
-            .avx      = f_1_ECX_[28] && avxsupport,
-            .avx2     = f_7_EBX_[5] && avxsupport,
-            .avx512f  = f_7_EBX_[16] && avx512support,
-            .avx512bw = f_7_EBX_[30] && avx512support,
-            .popcnt   = f_1_ECX_[23],
-            .bmi      = f_7_EBX_[3],
+            .sse        = f_1_EDX_[25],
+            .sse2       = f_1_EDX_[26],
+            .sse3       = f_1_ECX_[0],
+            .ssse3      = f_1_ECX_[9],
+            .sse41      = f_1_ECX_[19],
+            .sse42      = f_1_ECX_[20],
+            .avx        = f_1_ECX_[28] && avxsupport,
+            .avx2       = f_7_EBX_[5] && avxsupport,
+            .avx512f    = f_7_EBX_[16] && avx512support,
+            .avx512bw   = f_7_EBX_[30] && avx512support,
+            .avx512vl   = f_7_EBX_[31] && avx512support,
+            .avx512vbmi = f_7_ECX_[1] && avx512support,
+            .popcnt     = f_1_ECX_[23],
+            .bmi        = f_7_EBX_[3],
+            .bmi2       = f_7_EBX_[8],
         };
+
+        // Fall back to the deterministic cache parameters if the OS doesn't report the cache sizes
+        const bool amd = std::string_view{vendor} == "AuthenticAMD";
+        const auto cacheLeaf = amd ? CPU_AMD_CACHE_INFO : CPU_INTEL_CACHE_INFO;
+        const auto maxLeaf = static_cast<std::uint32_t>(amd ? extInfo.eax : info.eax);
+        if (this->caches.l1d_size == 0 && maxLeaf >= static_cast<std::uint32_t>(cacheLeaf)) {
+            for (int subLeaf = 0; subLeaf < 16; subLeaf++) {
+                const auto cache = ::cpuidex_impl(cacheLeaf, subLeaf);
+                const auto type = cache.eax & 0x1F; // 0: no more caches, 1: data, 2: instruction, 3: unified
+                if (type == 0) {
+                    break;
+                }
+                if (type == 2) {
+                    continue;
+                }
+                const auto ebx = static_cast<std::uint32_t>(cache.ebx);
+                const std::size_t lineSize = (ebx & 0xFFF) + 1;
+                const std::size_t partitions = ((ebx >> 12) & 0x3FF) + 1;
+                const std::size_t ways = ((ebx >> 22) & 0x3FF) + 1;
+                const std::size_t sets = static_cast<std::uint32_t>(cache.ecx) + std::size_t{1};
+                const auto size = ways * partitions * lineSize * sets;
+                switch ((cache.eax >> 5) & 0x7) {
+                    case 1:
+                        this->caches.l1d_size = size;
+                        this->caches.line_size = lineSize;
+                        break;
+                    case 2: this->caches.l2_size = size; break;
+                    case 3: this->caches.l3_size = size; break;
+                    default: break;
+                }
+            }
+        }
     }
 }
 #endif
@@ -0,0 +1,108 @@
+#include <libhat/defines.hpp>
+
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+
+#include "../../Xrefs.hpp"
+
+#include <bit>
+
+#include <immintrin.h>
+
+namespace hat::detail {
+
+    LIBHAT_TARGET("avx,avx2")
+    LIBHAT_FORCEINLINE static __m256i byte_equals(const __m256i bytes, const std::uint8_t value) {
+        return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(static_cast<char>(value)));
+    }
+
+    LIBHAT_TARGET("avx,avx2")
+    std::size_t find_xref_candidates_avx2(const std::byte* data, const std::size_t begin, const std::size_t end, const xref_filter filter, std::vector<std::size_t>& out) {
+        // The dwords at positions 4k + j are loaded at offset j, and only the jth byte of their comparison is kept, so
+        // that the four comparisons combine into one byte per position
+        const auto limit = _mm256_set1_epi32(static_cast<int>(filter.limit));
+        const auto start = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(begin) - filter.bias));
+        __m256i positions[4];
+        __m256i lanes[4];
+        for (int j = 0; j < 4; j++) {
+            positions[j] = _mm256_add_epi32(start, _mm256_setr_epi32(j, j + 4, j + 8, j + 12, j + 16, j + 20, j + 24, j + 28));
+            lanes[j] = _mm256_set1_epi32(static_cast<int>(0xFFu << (8 * j)));
+        }
+        const auto step = _mm256_set1_epi32(32);
+
+        auto i = begin;
+        for (; i + 32 <= end; i += 32) {
+            auto inRange = _mm256_setzero_si256();
+            for (int j = 0; j < 4; j++) {
+                const auto disp = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + j));
+                const auto offset = _mm256_add_epi32(disp, positions[j]);
+                const auto below = _mm256_cmpeq_epi32(_mm256_min_epu32(offset, limit), offset);
+                inRange = _mm256_or_si256(inRange, _mm256_and_si256(below, lanes[j]));
+                positions[j] = _mm256_add_epi32(positions[j], step);
+            }
+
+            const auto b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 1));
+            const auto b2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 2));
+            const auto callJmp = byte_equals(_mm256_or_si256(b1, _mm256_set1_epi8(0x01)), 0xE9);
+            const auto jcc = _mm256_and_si256(byte_equals(b2, 0x0F), byte_equals(_mm256_and_si256(b1, _mm256_set1_epi8(static_cast<char>(0xF0))), 0x80));
+            const auto ripRelative = byte_equals(_mm256_and_si256(b1, _mm256_set1_epi8(static_cast<char>(0xC7))), 0x05);
+            const auto modrmOpcode = _mm256_or_si256(
+                _mm256_or_si256(byte_equals(b2, 0x8D), byte_equals(b2, 0xFF)),
+                byte_equals(_mm256_and_si256(b2, _mm256_set1_epi8(static_cast<char>(0xFD))), 0x89)); // 89 and 8B
+            const auto opcode = _mm256_or_si256(_mm256_or_si256(callJmp, jcc), _mm256_and_si256(ripRelative, modrmOpcode));
+
+            auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(inRange, opcode)));
+            for (; mask; mask &= mask - 1) {
+                out.push_back(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+        }
+        return i;
+    }
+
+#if defined(LIBHAT_FEATURE_SSE)
+    LIBHAT_TARGET("sse4.1")
+    LIBHAT_FORCEINLINE static __m128i set1(const std::uint32_t value) {
+        return _mm_set1_epi32(static_cast<int>(value));
+    }
+
+    /// Unsigned value <= limit, lane by lane
+    LIBHAT_TARGET("sse4.1")
+    LIBHAT_FORCEINLINE static __m128i below(const __m128i value, const __m128i limit) {
+        return _mm_cmpeq_epi32(_mm_min_epu32(value, limit), value);
+    }
+
+    LIBHAT_TARGET("sse4.1")
+    std::size_t find_xref_candidates_aarch64_sse(const std::byte* data, const std::size_t count, const std::uint32_t pc, const xref_filter_aarch64& filter, std::vector<std::size_t>& out) {
+        const auto branchOpcode = set1(filter.branchOpcode);
+        const auto branchBias = set1(filter.branchBias);
+        const auto branchLimit = set1(filter.branchLimit);
+        const auto adrpOpcode = set1(filter.adrpOpcode);
+        const auto pageBias = set1(filter.pageBias);
+        const auto pageLimit = set1(filter.pageLimit);
+        auto pcs = _mm_add_epi32(set1(pc), _mm_setr_epi32(0, 4, 8, 12));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const auto words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4));
+
+            const auto isBranch = _mm_cmpeq_epi32(_mm_and_si128(words, set1(0x7C000000)), branchOpcode);
+            const auto offset = _mm_add_epi32(_mm_slli_epi32(words, 6), _mm_slli_epi32(_mm_sub_epi32(pcs, branchBias), 4));
+            const auto branch = _mm_and_si128(isBranch, below(offset, branchLimit));
+
+            const auto isAdrp = _mm_cmpeq_epi32(_mm_and_si128(words, set1(0x9F000000)), adrpOpcode);
+            const auto immediate = _mm_or_si128(
+                _mm_and_si128(_mm_slli_epi32(words, 9), set1(0xFFFFC000)),
+                _mm_and_si128(_mm_srli_epi32(words, 17), set1(0x3000)));
+            const auto page = _mm_sub_epi32(_mm_add_epi32(immediate, _mm_and_si128(pcs, set1(~0xFFFu))), pageBias);
+            const auto adrp = _mm_and_si128(isAdrp, below(page, pageLimit));
+
+            auto mask = static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(branch, adrp))));
+            for (; mask; mask &= mask - 1) {
+                out.push_back(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+            pcs = _mm_add_epi32(pcs, set1(16));
+        }
+        return i;
+    }
+#endif
+}
+#endif
@@ -180,6 +180,36 @@ namespace hat::process {
         return {reinterpret_cast<std::byte*>(mimpl->address()), max};
     }
 
+    std::span<const std::byte> module::build_id() const {
+        const auto mimpl = static_cast<const module_implementation*>(this->impl.get());
+
+        for (auto& header : mimpl->headers()) {
+            if (header.p_type != PT_NOTE) {
+                continue;
+            }
+            // The name and descriptor of each note are padded to the alignment of the segment, which is 4 or 8
+            const std::size_t align = header.p_align == 8 ? 8 : 4;
+            const auto padded = [&](const std::size_t size) { return (size + align - 1) & ~(align - 1); };
+
+            const auto* it = reinterpret_cast<const std::byte*>(mimpl->address() + header.p_vaddr);
+            const auto* end = it + header.p_memsz;
+            while (static_cast<std::size_t>(end - it) >= sizeof(ElfW(Nhdr))) {
+                ElfW(Nhdr) note{};
+                std::memcpy(&note, it, sizeof(note));
+                const auto* name = it + sizeof(note);
+                const auto* desc = name + padded(note.n_namesz);
+                if (desc + note.n_descsz > end) {
+                    break;
+                }
+                if (note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0) {
+                    return {desc, note.n_descsz};
+                }
+                it = desc + padded(note.n_descsz);
+            }
+        }
+        return {};
+    }
+
     std::span<std::byte> module::get_executable_data() const {
         if (const auto text = this->get_section_data(".text"); !text.empty()) {
             return text;
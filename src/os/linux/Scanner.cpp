@@ -0,0 +1,52 @@
+#include <libhat/defines.hpp>
+#ifdef LIBHAT_LINUX
+
+#include <libhat/pointers.hpp>
+#include <libhat/scanner.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace hat::experimental {
+
+    template<>
+    scan_result find_vtable<compiler_type::GNU>(const std::string& className, const hat::process::module& mod) {
+        // Tracing cross-references, see hat::rtti_index for the layouts
+        // Type Name => Type Info => VTable
+        const std::span<const std::byte> rodata = mod.get_section_data(".rodata");
+        std::span<const std::byte> data = mod.get_section_data(".data.rel.ro");
+        if (data.empty()) {
+            // Without position independent code, the type info and vtables are read-only data
+            data = rodata;
+        }
+
+        // Names may be merged with the end of longer names, so every occurrence is a candidate
+        const auto name = std::to_string(className.size()) + className;
+        const auto sig = string_to_signature(std::string_view{name.c_str(), name.size() + 1}).value();
+        std::vector<std::uintptr_t> names{};
+        for (const auto result : find_all_pattern(rodata, sig)) {
+            names.push_back(reinterpret_cast<std::uintptr_t>(result.get()));
+        }
+        if (names.empty()) {
+            return nullptr;
+        }
+
+        for (const auto namePointer : find_pointers(data, names)) {
+            // A single pointer is the offset from the type name pointer to the start of the type info
+            const auto typeInfo = namePointer.get() - sizeof(void*);
+            for (const auto typeInfoPointer : find_pointers(data, reinterpret_cast<std::uintptr_t>(typeInfo))) {
+                const auto offset = static_cast<std::size_t>(typeInfoPointer.get() - data.data());
+                std::uintptr_t offsetToTop = 1;
+                if (offset >= sizeof(void*)) {
+                    std::memcpy(&offsetToTop, typeInfoPointer.get() - sizeof(void*), sizeof(offsetToTop));
+                }
+                if (offsetToTop == 0) {
+                    return const_cast<std::byte*>(data.data() + offset + sizeof(void*));
+                }
+            }
+        }
+        return nullptr;
+    }
+}
+#endif
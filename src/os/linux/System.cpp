@@ -0,0 +1,186 @@
+#include <libhat/defines.hpp>
+#ifdef LIBHAT_LINUX
+
+#include <libhat/system.hpp>
+
+#include "../unix/System.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace hat::detail {
+
+    static std::optional<std::string> read_line(const std::filesystem::path& path) {
+        std::ifstream file{path};
+        std::string line;
+        if (!std::getline(file, line)) {
+            return std::nullopt;
+        }
+        return line;
+    }
+
+    static std::optional<std::size_t> read_number(const std::filesystem::path& path) {
+        const auto line = read_line(path);
+        if (!line) {
+            return std::nullopt;
+        }
+        std::size_t value{};
+        const auto end = line->data() + line->size();
+        const auto [ptr, ec] = std::from_chars(line->data(), end, value);
+        if (ec != std::errc{}) {
+            return std::nullopt;
+        }
+        // Cache sizes are reported with a unit suffix, such as "48K"
+        if (ptr != end && *ptr == 'K') value <<= 10;
+        if (ptr != end && *ptr == 'M') value <<= 20;
+        return value;
+    }
+
+    /// Parses the cpulist format used by sysfs, such as "0-3,8,10-11"
+    static std::vector<std::size_t> read_cpu_list(const std::filesystem::path& path) {
+        std::vector<std::size_t> cpus{};
+        const auto line = read_line(path);
+        if (!line) {
+            return cpus;
+        }
+        const char* it = line->data();
+        const char* end = line->data() + line->size();
+        while (it < end) {
+            std::size_t first{};
+            auto res = std::from_chars(it, end, first);
+            if (res.ec != std::errc{}) {
+                break;
+            }
+            std::size_t last = first;
+            if (res.ptr != end && *res.ptr == '-') {
+                res = std::from_chars(res.ptr + 1, end, last);
+                if (res.ec != std::errc{}) {
+                    break;
+                }
+            }
+            for (auto cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+            it = res.ptr + 1; // +1 to skip the comma
+        }
+        return cpus;
+    }
+
+    static void load_cpu_caches(system_info& info, const std::filesystem::path& cpu) {
+        std::error_code ec{};
+        for (const auto& entry : std::filesystem::directory_iterator{cpu / "cache", ec}) {
+            if (!entry.path().filename().string().starts_with("index")) {
+                continue;
+            }
+            const auto level = read_number(entry.path() / "level");
+            const auto type = read_line(entry.path() / "type");
+            const auto size = read_number(entry.path() / "size");
+            if (!level || !type || !size || *type == "Instruction") {
+                continue;
+            }
+            switch (*level) {
+                case 1:
+                    info.caches.l1d_size = *size;
+                    info.caches.line_size = read_number(entry.path() / "coherency_line_size").value_or(0);
+                    break;
+                case 2: info.caches.l2_size = *size; break;
+                case 3: info.caches.l3_size = *size; break;
+                default: break;
+            }
+        }
+    }
+
+    void load_cpu_topology(system_info& info) {
+        const std::filesystem::path cpuRoot{"/sys/devices/system/cpu"};
+
+        auto online = read_cpu_list(cpuRoot / "online");
+        if (online.empty()) {
+            const auto count = static_cast<std::size_t>(std::max(1L, sysconf(_SC_NPROCESSORS_ONLN)));
+            for (std::size_t cpu = 0; cpu < count; cpu++) {
+                online.push_back(cpu);
+            }
+        }
+
+        // Map each CPU to its NUMA node
+        std::map<std::size_t, std::size_t> nodes{};
+        std::error_code ec{};
+        for (const auto& entry : std::filesystem::directory_iterator{"/sys/devices/system/node", ec}) {
+            const auto name = entry.path().filename().string();
+            std::size_t node{};
+            if (!name.starts_with("node")
+                || std::from_chars(name.data() + 4, name.data() + name.size(), node).ec != std::errc{}) {
+                continue;
+            }
+            for (const auto cpu : read_cpu_list(entry.path() / "cpulist")) {
+                nodes[cpu] = node;
+            }
+            info.numa_nodes++;
+        }
+        info.numa_nodes = std::max<std::size_t>(info.numa_nodes, 1);
+
+        // Intel hybrid CPUs expose a PMU per core type, ARM big.LITTLE CPUs report a relative capacity per core
+        const auto performanceCores = read_cpu_list("/sys/devices/cpu_core/cpus");
+        const auto efficiencyCores = read_cpu_list("/sys/devices/cpu_atom/cpus");
+        std::map<std::size_t, std::size_t> capacities{};
+        std::size_t maxCapacity{};
+
+        std::map<std::pair<std::size_t, std::size_t>, std::size_t> physicalIds{};
+        for (const auto cpu : online) {
+            const auto path = cpuRoot / ("cpu" + std::to_string(cpu));
+            const auto package = read_number(path / "topology" / "physical_package_id").value_or(0);
+            const auto core = read_number(path / "topology" / "core_id").value_or(cpu);
+            const auto [it, inserted] = physicalIds.try_emplace({package, core}, physicalIds.size());
+
+            if (const auto capacity = read_number(path / "cpu_capacity")) {
+                capacities[cpu] = *capacity;
+                maxCapacity = std::max(maxCapacity, *capacity);
+            }
+
+            info.cores.push_back({
+                .logical_id = cpu,
+                .physical_id = it->second,
+                .numa_node = nodes.contains(cpu) ? nodes[cpu] : 0,
+            });
+        }
+
+        for (auto& core : info.cores) {
+            const auto cpu = core.logical_id;
+            if (!performanceCores.empty() && !efficiencyCores.empty()) {
+                core.type = std::ranges::find(efficiencyCores, cpu) != efficiencyCores.end()
+                    ? cpu_core_type::efficiency
+                    : cpu_core_type::performance;
+            } else if (capacities.contains(cpu)) {
+                core.type = capacities[cpu] == maxCapacity
+                    ? cpu_core_type::performance
+                    : cpu_core_type::efficiency;
+            }
+        }
+
+        info.logical_cores = info.cores.size();
+        info.physical_cores = physicalIds.size();
+        info.hybrid = std::ranges::any_of(info.cores, [](const cpu_core_info& core) {
+            return core.type == cpu_core_type::efficiency;
+        });
+        if (!info.hybrid) {
+            for (auto& core : info.cores) {
+                core.type = cpu_core_type::unknown;
+            }
+        }
+
+        if (!online.empty()) {
+            load_cpu_caches(info, cpuRoot / ("cpu" + std::to_string(online.front())));
+        }
+    }
+}
+
+#endif
@@ -195,6 +195,22 @@ namespace hat::process {
         return {reinterpret_cast<std::byte*>(mimpl->address()), max};
     }
 
+    std::span<const std::byte> module::build_id() const {
+        const auto mimpl = static_cast<const module_implementation*>(this->impl.get());
+        const auto* header = reinterpret_cast<const mach_header_t*>(mimpl->address());
+
+        const auto* cmd = reinterpret_cast<const load_command*>(
+            reinterpret_cast<const std::byte*>(header) + sizeof(mach_header_t));
+        for (std::uint32_t i = 0; i < header->ncmds; i++) {
+            if (cmd->cmd == LC_UUID) {
+                return std::as_bytes(std::span{reinterpret_cast<const uuid_command*>(cmd)->uuid});
+            }
+            cmd = reinterpret_cast<const load_command*>(
+                reinterpret_cast<const std::byte*>(cmd) + cmd->cmdsize);
+        }
+        return {};
+    }
+
     std::span<std::byte> module::get_executable_data() const {
         if (const auto text = this->get_section_data("__TEXT,__text"); !text.empty()) {
             return text;
@@ -0,0 +1,51 @@
+#include <libhat/defines.hpp>
+#ifdef LIBHAT_MAC
+
+#include <libhat/system.hpp>
+
+#include "../unix/System.hpp"
+
+#include <cstdint>
+
+#include <sys/sysctl.h>
+
+namespace hat::detail {
+
+    static std::size_t read_sysctl(const char* name) {
+        std::int64_t value{};
+        std::size_t size = sizeof(value);
+        if (sysctlbyname(name, &value, &size, nullptr, 0) != 0) {
+            return 0;
+        }
+        // Some values are 32-bit, which only fill the low bytes on little endian targets
+        return static_cast<std::size_t>(size == sizeof(std::int32_t) ? static_cast<std::int32_t>(value) : value);
+    }
+
+    void load_cpu_topology(system_info& info) {
+        info.logical_cores = read_sysctl("hw.logicalcpu");
+        info.physical_cores = read_sysctl("hw.physicalcpu");
+        info.numa_nodes = 1;
+        info.caches.l1d_size = read_sysctl("hw.l1dcachesize");
+        info.caches.l2_size = read_sysctl("hw.l2cachesize");
+        info.caches.l3_size = read_sysctl("hw.l3cachesize");
+        info.caches.line_size = read_sysctl("hw.cachelinesize");
+
+        // Apple silicon describes its core types as performance levels, with the fastest first. The logical
+        // processors aren't numbered by level, so their types are left unknown.
+        info.hybrid = read_sysctl("hw.nperflevels") > 1;
+        if (info.hybrid) {
+            info.caches.l1d_size = read_sysctl("hw.perflevel0.l1dcachesize");
+            info.caches.l2_size = read_sysctl("hw.perflevel0.l2cachesize");
+        }
+
+        const auto threadsPerCore = info.physical_cores ? info.logical_cores / info.physical_cores : 1;
+        for (std::size_t cpu = 0; cpu < info.logical_cores; cpu++) {
+            info.cores.push_back({
+                .logical_id = cpu,
+                .physical_id = threadsPerCore ? cpu / threadsPerCore : cpu,
+            });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include <libhat/defines.hpp>
+#ifdef LIBHAT_UNIX
+
+#include "../../MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hat::detail {
+
+    mapped_file::mapped_file(const std::filesystem::path& path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            return;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            const auto size = static_cast<std::size_t>(st.st_size);
+            // The mapping stays valid after the descriptor is closed
+            if (void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); data != MAP_FAILED) {
+                this->data_ = static_cast<const std::byte*>(data);
+                this->size_ = size;
+            }
+        }
+        close(fd);
+    }
+
+    mapped_file::~mapped_file() {
+        if (this->data_) {
+            munmap(const_cast<std::byte*>(this->data_), this->size_);
+        }
+    }
+}
+
+#endif
@@ -4,10 +4,13 @@
 #include <libhat/system.hpp>
 #include <unistd.h>
 
+#include "System.hpp"
+
 namespace hat {
 
     system_info::system_info() {
         this->page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        detail::load_cpu_topology(*this);
     }
 }
 
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <libhat/system.hpp>
+
+namespace hat::detail {
+
+    /// Fills in the core counts, cores, and cache sizes of the system info from the OS
+    void load_cpu_topology(system_info& info);
+}
@@ -0,0 +1,44 @@
+#include <libhat/defines.hpp>
+#ifdef LIBHAT_WINDOWS
+
+#include "../../MappedFile.hpp"
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+
+namespace hat::detail {
+
+    mapped_file::mapped_file(const std::filesystem::path& path) {
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER size{};
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            if (const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                // The view keeps the mapping alive after its handle is closed
+                if (const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+                    this->data_ = static_cast<const std::byte*>(data);
+                    this->size_ = static_cast<std::size_t>(size.QuadPart);
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+
+    mapped_file::~mapped_file() {
+        if (this->data_) {
+            UnmapViewOfFile(this->data_);
+        }
+    }
+}
+
+#endif
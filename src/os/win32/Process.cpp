@@ -12,6 +12,7 @@
 #include <Windows.h>
 
 #include <bit>
+#include <cstring>
 #include <string>
 #include <span>
 
@@ -136,6 +137,28 @@ namespace hat::process {
         return {scanBytes, sizeOfImage};
     }
 
+    std::span<const std::byte> module::build_id() const {
+        const auto* base = reinterpret_cast<const std::byte*>(this->address());
+        const auto& directory = getNTHeaders(*this).OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG];
+        const std::span entries{
+            reinterpret_cast<const IMAGE_DEBUG_DIRECTORY*>(base + directory.VirtualAddress),
+            directory.VirtualAddress ? directory.Size / sizeof(IMAGE_DEBUG_DIRECTORY) : 0
+        };
+
+        for (const auto& entry : entries) {
+            // An "RSDS" signature followed by the GUID and age of the PDB
+            constexpr std::size_t rsdsSize = 24;
+            if (entry.Type != IMAGE_DEBUG_TYPE_CODEVIEW || !entry.AddressOfRawData || entry.SizeOfData < rsdsSize) {
+                continue;
+            }
+            const auto* record = base + entry.AddressOfRawData;
+            if (std::memcmp(record, "RSDS", 4) == 0) {
+                return {record + 4, rsdsSize - 4};
+            }
+        }
+        return {};
+    }
+
     std::span<std::byte> module::get_executable_data() const {
         if (const auto text = this->get_section_data(".text"); !text.empty()) {
             return text;
@@ -3,6 +3,11 @@
 
 #include <libhat/system.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <memory>
+
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif
@@ -13,10 +18,93 @@
 
 namespace hat {
 
+    static void load_cpu_topology(system_info& info) {
+        DWORD length{};
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+            return;
+        }
+        const auto buffer = std::make_unique<std::byte[]>(length);
+        if (!GetLogicalProcessorInformationEx(RelationAll,
+            reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get()), &length)) {
+            return;
+        }
+
+        // Logical processors are identified by their group and their bit in the group's affinity mask
+        const auto for_each_processor = [](const GROUP_AFFINITY& affinity, auto&& callback) {
+            for (auto mask = static_cast<std::uint64_t>(affinity.Mask); mask; mask &= mask - 1) {
+                callback(std::size_t{affinity.Group} * 64 + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+        };
+
+        std::map<std::size_t, std::size_t> nodes{};
+        std::map<std::size_t, cpu_core_info> cores{};
+        std::map<std::size_t, BYTE> efficiencyClasses{};
+        BYTE minEfficiency = 0xFF, maxEfficiency = 0;
+        for (DWORD offset = 0; offset < length;) {
+            const auto& entry = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.get() + offset);
+            offset += entry.Size;
+            switch (entry.Relationship) {
+                case RelationProcessorCore: {
+                    const auto physicalId = info.physical_cores++;
+                    minEfficiency = std::min(minEfficiency, entry.Processor.EfficiencyClass);
+                    maxEfficiency = std::max(maxEfficiency, entry.Processor.EfficiencyClass);
+                    for (WORD i = 0; i < entry.Processor.GroupCount; i++) {
+                        for_each_processor(entry.Processor.GroupMask[i], [&](const std::size_t cpu) {
+                            cores[cpu] = {.logical_id = cpu, .physical_id = physicalId};
+                            efficiencyClasses[cpu] = entry.Processor.EfficiencyClass;
+                        });
+                    }
+                    break;
+                }
+                case RelationNumaNode:
+                    info.numa_nodes++;
+                    for_each_processor(entry.NumaNode.GroupMask, [&](const std::size_t cpu) {
+                        nodes[cpu] = entry.NumaNode.NodeNumber;
+                    });
+                    break;
+                case RelationCache: {
+                    const auto& cache = entry.Cache;
+                    if (cache.Type == CacheInstruction) {
+                        break;
+                    }
+                    // Every core reports its own caches, the first one of each level is kept
+                    auto& size = cache.Level == 1 ? info.caches.l1d_size
+                        : cache.Level == 2 ? info.caches.l2_size
+                        : info.caches.l3_size;
+                    if (cache.Level <= 3 && size == 0) {
+                        size = cache.CacheSize;
+                        if (cache.Level == 1) {
+                            info.caches.line_size = cache.LineSize;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        info.hybrid = minEfficiency != maxEfficiency;
+        for (auto& [cpu, core] : cores) {
+            core.numa_node = nodes.contains(cpu) ? nodes[cpu] : 0;
+            if (info.hybrid) {
+                // A higher efficiency class means higher performance, at a higher power draw
+                core.type = efficiencyClasses[cpu] == maxEfficiency
+                    ? cpu_core_type::performance
+                    : cpu_core_type::efficiency;
+            }
+            info.cores.push_back(core);
+        }
+        info.logical_cores = info.cores.size();
+        info.numa_nodes = std::max<std::size_t>(info.numa_nodes, 1);
+    }
+
     system_info::system_info() {
         SYSTEM_INFO sysInfo;
         GetSystemInfo(&sysInfo);
         this->page_size = sysInfo.dwPageSize;
+        load_cpu_topology(*this);
     }
 }
 
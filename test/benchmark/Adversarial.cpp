@@ -0,0 +1,57 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libhat/scanner.hpp>
+
+// Patterns whose best anchor pair is made of the filler byte, as happens when a signature covers padding
+static constexpr std::string_view padding_pattern = "CC CC 48 8B 05 ? ? ? ? E8";
+static constexpr std::string_view zero_pattern = "00 00 00 00 E8 ? ? ? ? 48 89";
+
+// Random bytes interleaved with long runs of the filler byte, like the padding between functions or zero-filled tables
+template<std::uint8_t Filler>
+static auto gen_filler_buffer(const size_t size) {
+    std::vector<std::byte> buffer(size, std::byte{Filler});
+    std::default_random_engine generator(123);
+    std::uniform_int_distribution<uint32_t> byteDistribution(0, 0xFF);
+    std::uniform_int_distribution<size_t> runDistribution(64, 1 << 16);
+    for (size_t i = 0; i < buffer.size();) {
+        // 1 in 4 bytes is random
+        const auto random = std::min(runDistribution(generator) / 3, buffer.size() - i);
+        for (size_t j = 0; j < random; j++) {
+            buffer[i + j] = static_cast<std::byte>(byteDistribution(generator));
+        }
+        i += random + runDistribution(generator);
+    }
+    return buffer;
+}
+
+template<std::uint8_t Filler, hat::scan_hint Hints>
+static void BM_Throughput_Filler(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const auto buf = gen_filler_buffer<Filler>(size);
+    const auto begin = std::to_address(buf.begin());
+    const auto end = std::to_address(buf.end());
+
+    const auto sig = hat::parse_signature(Filler == 0xCC ? padding_pattern : zero_pattern).value();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_pattern(begin, end, sig, hat::scan_alignment::X1, Hints));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static constexpr int64_t rangeStart = 1 << 22; // 4 MiB
+static constexpr int64_t rangeLimit = 1 << 26; // 64 MiB
+
+#define LIBHAT_BENCHMARK(...) BENCHMARK(__VA_ARGS__) \
+    ->Threads(1)                                     \
+    ->MinWarmUpTime(1)                               \
+    ->MinTime(2)                                     \
+    ->Range(rangeStart, rangeLimit)                  \
+    ->UseRealTime();
+
+LIBHAT_BENCHMARK(BM_Throughput_Filler<0xCC, hat::scan_hint::none>);
+LIBHAT_BENCHMARK(BM_Throughput_Filler<0xCC, hat::scan_hint::adaptive_anchor>);
+LIBHAT_BENCHMARK(BM_Throughput_Filler<0x00, hat::scan_hint::none>);
+LIBHAT_BENCHMARK(BM_Throughput_Filler<0x00, hat::scan_hint::adaptive_anchor>);
+
+BENCHMARK_MAIN();
@@ -1,7 +1,7 @@
-#include <fstream>
 #include <filesystem>
 
 #include <benchmark/benchmark.h>
+#include <libhat/pe_image.hpp>
 #include <libhat/scanner.hpp>
 
 #include <format>
@@ -23,22 +23,16 @@ static const hat::signature DllMainSignature = [] {
 }();
 
 static std::span<const std::byte> get_file_data() {
-    static std::vector<std::byte> data = []{
-        const std::filesystem::path path{WIDE_STR(CHROME_DLL_PATH)};
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            std::terminate();
-        }
-
-        file.seekg(0, std::ios::end);
-        const std::streampos fileSize = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        std::vector<std::byte> contents(static_cast<size_t>(fileSize));
-        file.read(reinterpret_cast<char*>(contents.data()), fileSize);
-        return contents;
-    }();
-    return data;
+    // The machine code of the DLL, rather than the whole file which also has the headers, data and resources
+    static const auto image = hat::pe_image::open(std::filesystem::path{WIDE_STR(CHROME_DLL_PATH)});
+    if (!image) {
+        std::terminate();
+    }
+    static const auto text = image->get_section_data(".text");
+    if (text.empty()) {
+        std::terminate();
+    }
+    return text;
 }
 
 static void BM_find(benchmark::State& state) {
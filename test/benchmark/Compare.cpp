@@ -62,6 +62,25 @@ static void BM_Throughput_std_find_std_equal(benchmark::State& state) {
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
 }
 
+// A signature made of a long run of known bytes, where skipping over the data competes with the anchor search
+template<hat::scan_mode Mode>
+static void BM_Throughput_long(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const auto buf = gen_random_buffer(size);
+    const auto begin = std::to_address(buf.begin());
+    const auto end = std::to_address(buf.end());
+
+    std::vector<hat::signature_element> sig(128);
+    for (size_t i = 0; i < sig.size(); i++) {
+        sig[i] = static_cast<std::byte>(i + 1);
+    }
+    const auto context = hat::detail::scan_context::create<Mode>(sig, hat::scan_alignment::X1, hat::scan_hint::none);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.scan(begin, end));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
 static void BM_Throughput_UC1(benchmark::State& state) {
     const size_t size = state.range(0);
     const auto buf = gen_random_buffer(size);
@@ -103,4 +122,16 @@ LIBHAT_BENCHMARK(BM_Throughput_std_find_std_equal);
 LIBHAT_BENCHMARK(BM_Throughput_UC1);
 LIBHAT_BENCHMARK(BM_Throughput_UC2);
 
+LIBHAT_BENCHMARK(BM_Throughput_long<hat::scan_mode::Horspool>);
+LIBHAT_BENCHMARK(BM_Throughput_long<hat::scan_mode::SWAR>);
+#if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
+LIBHAT_BENCHMARK(BM_Throughput_long<hat::scan_mode::AVX2>);
+#endif
+#ifdef LIBHAT_X86_64
+LIBHAT_BENCHMARK(BM_Throughput_long<hat::scan_mode::AVX512>);
+#endif
+#if defined(LIBHAT_AARCH64) || defined(LIBHAT_ARM)
+LIBHAT_BENCHMARK(BM_Throughput_long<hat::scan_mode::Neon>);
+#endif
+
 BENCHMARK_MAIN();
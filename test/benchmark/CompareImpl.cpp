@@ -42,6 +42,7 @@ static constexpr int64_t rangeLimit = 1 << 28; // 256 MiB
     ->UseRealTime();
 
 LIBHAT_BENCHMARK(BM_Throughput<hat::detail::scan_mode::Single>);
+LIBHAT_BENCHMARK(BM_Throughput<hat::detail::scan_mode::SWAR>);
 #if defined(LIBHAT_AARCH64) || defined(LIBHAT_ARM)
 LIBHAT_BENCHMARK(BM_Throughput<hat::detail::scan_mode::Neon>);
 #endif
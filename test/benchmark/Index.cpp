@@ -0,0 +1,87 @@
+#include <cstring>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libhat/module_index.hpp>
+#include <libhat/scanner.hpp>
+
+static auto gen_random_buffer(const size_t size) {
+    std::vector<std::byte> buffer(size);
+    std::default_random_engine generator(123);
+    std::uniform_int_distribution<uint64_t> distribution(0, 0xFFFFFFFFFFFFFFFF);
+    for (size_t i = 0; i < buffer.size(); i += 8) {
+        uint64_t value = distribution(generator);
+        std::memcpy(&buffer[i], &value, sizeof(value));
+    }
+    return buffer;
+}
+
+// Signatures copied from the buffer with a few wildcards, like the typical "48 8B 05 ? ? ? ?" displacements
+static auto gen_queries(const std::vector<std::byte>& buffer, const size_t count) {
+    std::vector<hat::signature> queries{};
+    std::default_random_engine generator(456);
+    std::uniform_int_distribution<size_t> offsetDistribution(0, buffer.size() - 32);
+    for (size_t i = 0; i < count; i++) {
+        const auto offset = static_cast<std::ptrdiff_t>(offsetDistribution(generator));
+        hat::signature sig(buffer.begin() + offset, buffer.begin() + offset + 24);
+        for (size_t j = 3; j < 7; j++) {
+            sig[j] = std::nullopt;
+        }
+        queries.push_back(std::move(sig));
+    }
+    return queries;
+}
+
+static void BM_Query_FindPattern(benchmark::State& state) {
+    const auto buf = gen_random_buffer(state.range(0));
+    const auto queries = gen_queries(buf, 256);
+    size_t i{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_pattern(buf.cbegin(), buf.cend(), queries[i++ % queries.size()]));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_Query_ModuleIndex(benchmark::State& state) {
+    const auto buf = gen_random_buffer(state.range(0));
+    const auto queries = gen_queries(buf, 256);
+    const hat::module_index index{buf, {.memory_budget = buf.size() * state.range(1) / 100}};
+    size_t i{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.find_pattern(queries[i++ % queries.size()]));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["stride"] = static_cast<double>(index.stride());
+    state.counters["index_bytes"] = static_cast<double>(index.memory_usage());
+}
+
+static void BM_Build_ModuleIndex(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const auto buf = gen_random_buffer(size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::module_index{buf, {.memory_budget = size * state.range(1) / 100}});
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static constexpr int64_t rangeStart = 1 << 22; // 4 MiB
+static constexpr int64_t rangeLimit = 1 << 26; // 64 MiB
+
+// The second argument is the memory budget of the index as a percentage of the buffer size, 0 for no limit
+#define LIBHAT_BENCHMARK(...) BENCHMARK(__VA_ARGS__)                             \
+    ->Threads(1)                                                                 \
+    ->MinWarmUpTime(1)                                                           \
+    ->MinTime(2)                                                                 \
+    ->ArgsProduct({benchmark::CreateRange(rangeStart, rangeLimit, 4), {0, 100}}) \
+    ->UseRealTime();
+
+BENCHMARK(BM_Query_FindPattern)
+    ->Threads(1)
+    ->MinWarmUpTime(1)
+    ->MinTime(2)
+    ->Range(rangeStart, rangeLimit)
+    ->UseRealTime();
+LIBHAT_BENCHMARK(BM_Query_ModuleIndex);
+LIBHAT_BENCHMARK(BM_Build_ModuleIndex);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,63 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libhat/pointers.hpp>
+#include <libhat/scanner.hpp>
+
+// Pointer sized values within a few distant regions, like a heap holding pointers to objects and into modules
+static auto gen_pointer_buffer(const size_t size) {
+    std::vector<uintptr_t> buffer(size / sizeof(uintptr_t));
+    std::default_random_engine generator(123);
+    std::uniform_int_distribution<uintptr_t> offsetDistribution(0, 0xFFFFFF);
+    const uintptr_t bases[]{0x10000000, 0x20000000, 0x30000000, 0x40000000};
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = bases[i % std::size(bases)] + offsetDistribution(generator);
+    }
+    return buffer;
+}
+
+// The alternative for a single value
+static void BM_Pointers_FindAllPattern(benchmark::State& state) {
+    const auto buf = gen_pointer_buffer(state.range(0));
+    const auto bytes = std::as_bytes(std::span{buf});
+    const auto sig = hat::object_to_signature(buf[buf.size() / 2]);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_all_pattern(bytes.begin(), bytes.end(), sig, hat::scan_alignment::X4));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+
+static void BM_Pointers_Value(benchmark::State& state) {
+    const auto buf = gen_pointer_buffer(state.range(0));
+    const auto bytes = std::as_bytes(std::span{buf});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_pointers(bytes, buf[buf.size() / 2]));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+
+// Any pointer into one of the regions, a quarter of the values
+static void BM_Pointers_Range(benchmark::State& state) {
+    const auto buf = gen_pointer_buffer(state.range(0));
+    const auto bytes = std::as_bytes(std::span{buf});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_pointers(bytes, hat::address_range{0x20000000, 0x21000000}));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+
+static constexpr int64_t rangeStart = 1 << 22; // 4 MiB
+static constexpr int64_t rangeLimit = 1 << 26; // 64 MiB
+
+#define LIBHAT_BENCHMARK(...) BENCHMARK(__VA_ARGS__) \
+    ->Threads(1)                                     \
+    ->MinWarmUpTime(1)                               \
+    ->MinTime(2)                                     \
+    ->Range(rangeStart, rangeLimit)                  \
+    ->UseRealTime();
+
+LIBHAT_BENCHMARK(BM_Pointers_FindAllPattern);
+LIBHAT_BENCHMARK(BM_Pointers_Value);
+LIBHAT_BENCHMARK(BM_Pointers_Range);
+
+BENCHMARK_MAIN();
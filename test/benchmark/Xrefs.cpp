@@ -0,0 +1,91 @@
+#include <cstring>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libhat/scanner.hpp>
+#include <libhat/xref.hpp>
+
+static auto gen_random_buffer(const size_t size) {
+    std::vector<std::byte> buffer(size);
+    std::default_random_engine generator(123);
+    std::uniform_int_distribution<uint64_t> distribution(0, 0xFFFFFFFFFFFFFFFF);
+    for (size_t i = 0; i < buffer.size(); i += 8) {
+        uint64_t value = distribution(generator);
+        std::memcpy(&buffer[i], &value, sizeof(value));
+    }
+    return buffer;
+}
+
+static auto gen_targets(const std::vector<std::byte>& buffer, const size_t count) {
+    std::vector<uintptr_t> targets{};
+    std::default_random_engine generator(456);
+    std::uniform_int_distribution<size_t> offsetDistribution(0, buffer.size() - 1);
+    for (size_t i = 0; i < count; i++) {
+        targets.push_back(reinterpret_cast<uintptr_t>(buffer.data() + offsetDistribution(generator)));
+    }
+    std::ranges::sort(targets);
+    return targets;
+}
+
+// The opcodes of hat::xref_kind, with the offset of their displacement
+static const std::pair<hat::signature, size_t> opcode_patterns[]{
+    {hat::parse_signature("E8").value(), 1},
+    {hat::parse_signature("E9").value(), 1},
+    {hat::parse_signature("0F 8?").value(), 2},
+    {hat::parse_signature("48 8D 05").value(), 3},
+    {hat::parse_signature("48 8B 05").value(), 3},
+    {hat::parse_signature("48 89 05").value(), 3},
+    {hat::parse_signature("FF 15").value(), 2},
+    {hat::parse_signature("FF 25").value(), 2},
+};
+
+// The alternative, a scan for every opcode and a comparison of the target of every match
+static void BM_Xrefs_FindAllPattern(benchmark::State& state) {
+    const auto buf = gen_random_buffer(state.range(0));
+    const auto targets = gen_targets(buf, state.range(1));
+    for (auto _ : state) {
+        size_t count{};
+        for (const auto& [pattern, offset] : opcode_patterns) {
+            for (const auto result : hat::find_all_pattern(buf.cbegin(), buf.cend() - 4, pattern)) {
+                count += std::ranges::binary_search(targets, reinterpret_cast<uintptr_t>(result.rel(offset)));
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buf.size()));
+}
+
+static void BM_Xrefs_FindXrefs(benchmark::State& state) {
+    const auto buf = gen_random_buffer(state.range(0));
+    const auto targets = gen_targets(buf, state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_xrefs(buf, targets));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buf.size()));
+}
+
+static void BM_Xrefs_FindXrefsAArch64(benchmark::State& state) {
+    const auto buf = gen_random_buffer(state.range(0));
+    const auto targets = gen_targets(buf, state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hat::find_xrefs_aarch64(buf, targets));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buf.size()));
+}
+
+static constexpr int64_t rangeStart = 1 << 22; // 4 MiB
+static constexpr int64_t rangeLimit = 1 << 26; // 64 MiB
+
+// The second argument is the number of targets
+#define LIBHAT_BENCHMARK(...) BENCHMARK(__VA_ARGS__)                               \
+    ->Threads(1)                                                                   \
+    ->MinWarmUpTime(1)                                                             \
+    ->MinTime(2)                                                                   \
+    ->ArgsProduct({benchmark::CreateRange(rangeStart, rangeLimit, 4), {1, 1024}}) \
+    ->UseRealTime();
+
+LIBHAT_BENCHMARK(BM_Xrefs_FindAllPattern);
+LIBHAT_BENCHMARK(BM_Xrefs_FindXrefs);
+LIBHAT_BENCHMARK(BM_Xrefs_FindXrefsAArch64);
+
+BENCHMARK_MAIN();
@@ -1,8 +1,32 @@
 #include <libhat/system.hpp>
 
+static const char* get_core_type_name(const hat::cpu_core_type type) {
+    switch (type) {
+        case hat::cpu_core_type::performance: return "performance";
+        case hat::cpu_core_type::efficiency: return "efficiency";
+        default: return "unknown";
+    }
+}
+
 int main() {
     const auto& system = hat::get_system();
-    
+
+    printf("page_size: %zu\n", system.page_size);
+    printf("physical_cores: %zu\n", system.physical_cores);
+    printf("logical_cores: %zu\n", system.logical_cores);
+    printf("numa_nodes: %zu\n", system.numa_nodes);
+    printf("hybrid: %d\n", system.hybrid);
+    // caches
+    printf("l1d_size: %zu\n", system.caches.l1d_size);
+    printf("l2_size: %zu\n", system.caches.l2_size);
+    printf("l3_size: %zu\n", system.caches.l3_size);
+    printf("line_size: %zu\n", system.caches.line_size);
+    // cores
+    for (const auto& core : system.cores) {
+        printf("cpu %zu: core %zu, node %zu, %s\n", core.logical_id, core.physical_id, core.numa_node,
+            get_core_type_name(core.type));
+    }
+
 #if defined(LIBHAT_X86) || defined(LIBHAT_X86_64)
     printf("cpu_vendor: %s\n", system.cpu_vendor.c_str());
     printf("cpu_brand: %s\n", system.cpu_brand.c_str());
@@ -18,8 +42,15 @@ int main() {
     printf("avx2: %d\n", ext.avx2);
     printf("avx512f: %d\n", ext.avx512f);
     printf("avx512bw: %d\n", ext.avx512bw);
+    printf("avx512vl: %d\n", ext.avx512vl);
+    printf("avx512vbmi: %d\n", ext.avx512vbmi);
     printf("popcnt: %d\n", ext.popcnt);
     printf("bmi: %d\n", ext.bmi);
+    printf("bmi2: %d\n", ext.bmi2);
+#endif
+
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+    printf("neon: %d\n", system.extensions.neon);
 #endif
 
     return 0;
@@ -1,9 +1,20 @@
 #include <gtest/gtest.h>
 
+#include <array>
 #include <bit>
-
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <typeinfo>
+
+#include <libhat/batch.hpp>
+#include <libhat/elf_image.hpp>
+#include <libhat/hash.hpp>
 #include <libhat/memory_protector.hpp>
 #include <libhat/process.hpp>
+#include <libhat/registry.hpp>
+#include <libhat/rtti.hpp>
+#include <libhat/scan_cache.hpp>
 #include <libhat/system.hpp>
 
 #ifdef LIBHAT_UNIX
@@ -268,3 +279,294 @@ TEST(ProcessTest, SystemAllocSymbolExists) {
     const auto proc = mod->get_symbol(SYM_LOOKUP_NAME);
     EXPECT_NE(proc, 0);
 }
+
+#ifdef LIBHAT_MAC
+    #define TEXT_SECTION "__TEXT,__text"
+#else
+    #define TEXT_SECTION ".text"
+#endif
+
+TEST(ProcessTest, ResolveAllMatchesFindPattern) {
+    const auto mod = hat::process::get_process_module();
+    const auto text = mod.get_section_data(TEXT_SECTION);
+    ASSERT_GT(text.size(), 0x10000);
+
+    // Byte sequences taken from all over the section, with a few wildcards, and one that can't be found
+    std::vector<hat::signature> signatures{};
+    for (std::size_t offset = 0; offset + 24 <= text.size(); offset += text.size() / 16 + 7) {
+        hat::signature signature{text.begin() + static_cast<std::ptrdiff_t>(offset), text.begin() + static_cast<std::ptrdiff_t>(offset + 24)};
+        signature[3] = std::nullopt;
+        signature[17] = std::nullopt;
+        signatures.push_back(std::move(signature));
+    }
+    signatures.push_back(hat::signature(24, hat::signature_element{std::byte{0xCC}}));
+    signatures.back()[0] = std::byte{0x0F};
+
+    std::vector<hat::scan_request> requests{};
+    for (const auto& signature : signatures) {
+        requests.push_back({.signature = signature, .section = TEXT_SECTION});
+    }
+    requests.push_back({.signature = signatures.front(), .section = TEXT_SECTION, .alignment = hat::scan_alignment::X16});
+
+    const auto results = hat::resolve_all(requests, mod, {.threads = 4, .block_size = 4096});
+    ASSERT_EQ(results.size(), requests.size());
+    for (std::size_t i = 0; i < requests.size(); i++) {
+        const auto expected = hat::find_pattern(requests[i].signature, TEXT_SECTION, mod, requests[i].alignment);
+        EXPECT_EQ(results[i].get(), expected.get()) << "request " << i;
+    }
+}
+
+TEST(ProcessTest, ScanCacheReusesOffsets) {
+    const auto mod = hat::process::get_process_module();
+    const auto text = mod.get_section_data(TEXT_SECTION);
+    ASSERT_GT(text.size(), 0x10000);
+
+    std::vector<hat::signature> signatures{};
+    for (std::size_t offset = 0x100; offset + 16 <= text.size(); offset += text.size() / 8) {
+        signatures.emplace_back(text.begin() + static_cast<std::ptrdiff_t>(offset), text.begin() + static_cast<std::ptrdiff_t>(offset + 16));
+    }
+    std::vector<hat::scan_request> requests{};
+    for (const auto& signature : signatures) {
+        requests.push_back({.signature = signature, .section = TEXT_SECTION});
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "libhat_test_scan_cache";
+    const auto path = directory / "cache.bin";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+
+    std::vector<hat::scan_result> expected{};
+    {
+        hat::scan_cache cache{path, mod};
+        expected = cache.resolve_all(requests);
+        EXPECT_EQ(cache.hits(), 0);
+        EXPECT_EQ(cache.misses(), requests.size());
+        EXPECT_TRUE(cache.save());
+    }
+    {
+        hat::scan_cache cache{path, mod};
+        for (std::size_t i = 0; i < requests.size(); i++) {
+            EXPECT_EQ(cache.find_pattern(signatures[i], TEXT_SECTION).get(), expected[i].get());
+            EXPECT_EQ(expected[i].get(), hat::find_pattern(signatures[i], TEXT_SECTION, mod).get());
+        }
+        EXPECT_EQ(cache.hits(), requests.size());
+        EXPECT_EQ(cache.misses(), 0);
+    }
+    {
+        // The offsets are only valid for the module they were found in
+        const auto other = hat::process::get_module(SYM_LOOKUP_MOD);
+        ASSERT_TRUE(other.has_value());
+        hat::scan_cache cache{path, *other};
+        (void) cache.find_pattern(signatures.front(), TEXT_SECTION);
+        EXPECT_EQ(cache.hits(), 0);
+    }
+    {
+        // A save that can't replace the file leaves no temporary file behind
+        const auto blocked = directory / "blocked";
+        std::filesystem::create_directories(blocked / "child");
+        hat::scan_cache cache{blocked, mod};
+        (void) cache.find_pattern(signatures.front(), TEXT_SECTION);
+        EXPECT_FALSE(cache.save());
+        std::filesystem::remove_all(blocked);
+    }
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator{directory}, std::filesystem::directory_iterator{}), 1);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ProcessTest, ModuleBuildId) {
+    const auto mod = hat::process::get_process_module();
+    const auto id = mod.build_id();
+#if defined(LIBHAT_LINUX) || defined(LIBHAT_MAC)
+    // Linked with a build id by default
+    EXPECT_FALSE(id.empty());
+#endif
+    EXPECT_EQ(id.data(), mod.build_id().data());
+}
+
+TEST(ProcessTest, ModuleContentHash) {
+    const auto mod = hat::process::get_process_module();
+    const auto text = mod.get_section_data(TEXT_SECTION);
+    EXPECT_EQ(mod.content_hash(TEXT_SECTION), hat::crc32c(text));
+    EXPECT_EQ(mod.content_hash("libhat_missing_section"), std::nullopt);
+}
+
+#ifdef LIBHAT_LINUX
+TEST(ProcessTest, RttiIndexFindsLibraryVTables) {
+    const auto mod = hat::process::get_module("libstdc++.so.6");
+    ASSERT_TRUE(mod.has_value());
+    const hat::rtti_index index{*mod};
+    EXPECT_GT(index.size(), 100);
+
+    // The constructor is in the library, which sets the vptr to the vtable there
+    const std::runtime_error error{"libhat"};
+    const auto entry = index.find("St13runtime_error");
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(reinterpret_cast<const std::type_info*>(entry->type_info)->name(), std::string_view{"St13runtime_error"});
+    const std::byte* vptr;
+    std::memcpy(&vptr, &error, sizeof(vptr));
+    EXPECT_EQ(entry->vtable, vptr);
+    EXPECT_EQ(index.find_vtable("St13runtime_error").get(), vptr);
+    EXPECT_FALSE(index.find("18RttiTestNonexistent").has_value());
+}
+#endif
+
+#ifdef LIBHAT_LINUX
+TEST(ProcessTest, ElfImageMatchesProcessModule) {
+    const auto image = hat::elf_image::open("/proc/self/exe");
+    ASSERT_TRUE(image.has_value());
+    EXPECT_EQ(image->type(), hat::elf_type::shared_object);
+    ASSERT_FALSE(image->segments().empty());
+
+    const auto mod = hat::process::get_process_module();
+    const auto text = mod.get_section_data(".text");
+    const auto fileText = image->get_section_data(".text");
+    ASSERT_EQ(fileText.size(), text.size());
+    EXPECT_TRUE(std::ranges::equal(fileText, text));
+
+    // The addresses in the file are relative to the load address of the first segment
+    const hat::signature signature{text.begin() + 0x100, text.begin() + 0x120};
+    const auto expected = hat::find_pattern(signature, ".text", mod);
+    const auto result = hat::find_pattern(signature, ".text", *image);
+    ASSERT_TRUE(result.has_result());
+    const auto address = image->address_of(result.get());
+    ASSERT_TRUE(address.has_value());
+    EXPECT_EQ(mod.address() + (*address - image->segments().front().virtual_address), reinterpret_cast<std::uintptr_t>(expected.get()));
+    EXPECT_EQ(image->address_to_offset(*address), static_cast<std::size_t>(result.get() - image->data().data()));
+}
+#endif
+
+#if defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+        #define LIBHAT_TEST_ASAN
+    #endif
+#elif defined(__SANITIZE_ADDRESS__)
+    #define LIBHAT_TEST_ASAN
+#endif
+
+// The read-only data of this module is swept, which ASan places redzones in
+#if defined(LIBHAT_LINUX) && !defined(LIBHAT_TEST_ASAN)
+
+// The key functions are defined out of line, which emits the type information and vtables in this module
+struct RttiTestBase {
+    virtual ~RttiTestBase();
+    virtual int value() const;
+};
+struct RttiTestDerived : RttiTestBase {
+    int value() const override;
+};
+RttiTestBase::~RttiTestBase() = default;
+int RttiTestBase::value() const { return 1; }
+int RttiTestDerived::value() const { return 2; }
+
+static const std::byte* vptr_of(const RttiTestBase& object) {
+    const std::byte* vptr;
+    std::memcpy(&vptr, &object, sizeof(vptr));
+    return vptr;
+}
+
+TEST(ProcessTest, RttiIndexFindsVTables) {
+    const hat::rtti_index index{};
+    const RttiTestBase base{};
+    const RttiTestDerived derived{};
+    const auto baseEntry = index.find(typeid(RttiTestBase).name());
+    const auto derivedEntry = index.find(typeid(RttiTestDerived).name());
+    ASSERT_TRUE(baseEntry.has_value());
+    ASSERT_TRUE(derivedEntry.has_value());
+    EXPECT_EQ(baseEntry->type_info, reinterpret_cast<const std::byte*>(&typeid(RttiTestBase)));
+    EXPECT_EQ(derivedEntry->type_info, reinterpret_cast<const std::byte*>(&typeid(RttiTestDerived)));
+    EXPECT_EQ(baseEntry->vtable, vptr_of(base));
+    EXPECT_EQ(derivedEntry->vtable, vptr_of(derived));
+}
+
+namespace {
+    struct RttiTestInternal : RttiTestBase {
+        int value() const override;
+    };
+    int RttiTestInternal::value() const { return 3; }
+}
+
+TEST(ProcessTest, RttiIndexFindsInternalClasses) {
+    const hat::rtti_index index{};
+    const RttiTestInternal internal{};
+    const auto& typeInfo = typeid(RttiTestInternal);
+#if defined(__GNUC__) && !defined(__clang__)
+    // GCC stores the name with a leading '*', which std::type_info::name strips
+    const char* storedName;
+    std::memcpy(&storedName, reinterpret_cast<const std::byte*>(&typeInfo) + sizeof(void*), sizeof(storedName));
+    EXPECT_EQ(storedName[0], '*');
+#endif
+    const auto entry = index.find(typeInfo.name());
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->type_info, reinterpret_cast<const std::byte*>(&typeInfo));
+    EXPECT_EQ(entry->vtable, vptr_of(internal));
+}
+
+TEST(ProcessTest, FindVTableGNU) {
+    using namespace hat::experimental;
+    const RttiTestDerived derived{};
+    EXPECT_EQ(find_vtable<compiler_type::GNU>("RttiTestDerived").get(), vptr_of(derived));
+    EXPECT_EQ(find_vtable<compiler_type::GNU>("RttiTestNonexistent").get(), nullptr);
+}
+#endif
+
+TEST(HashTest, CRC32C) {
+    const std::string_view check = "123456789";
+    EXPECT_EQ(hat::crc32c(std::as_bytes(std::span{check})), 0xE3069283);
+    EXPECT_EQ(hat::crc32c({}), 0);
+
+    // Larger than the interleaved streams of the hardware implementations, continued at an odd offset
+    std::vector<std::byte> buffer(100'003);
+    for (std::size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<std::byte>(i * 31 + (i >> 7));
+    }
+    const std::span data{buffer};
+    std::uint32_t expected = 0;
+    for (const auto b : data) {
+        expected = hat::crc32c(std::span{&b, 1}, expected);
+    }
+    EXPECT_EQ(hat::crc32c(data), expected);
+    EXPECT_EQ(hat::crc32c(data.subspan(40'001), hat::crc32c(data.first(40'001))), expected);
+}
+
+#ifdef LIBHAT_HAS_CONSTEXPR_RESULT
+
+// The marker is placed in its own section, because the vectorized scanners read the redzones which ASan places around
+// globals in the default sections
+#if defined(LIBHAT_WINDOWS)
+    #pragma section(".hatreg", read)
+    #define REGISTRY_SECTION ".hatreg"
+    #define REGISTRY_MARKER __declspec(allocate(".hatreg"))
+#elif defined(LIBHAT_MAC)
+    #define REGISTRY_SECTION "__DATA,__hatreg"
+    #define REGISTRY_MARKER __attribute__((used, section(REGISTRY_SECTION)))
+#elif defined(__clang__)
+    #define REGISTRY_SECTION ".hatreg"
+    #define REGISTRY_MARKER __attribute__((used, section(REGISTRY_SECTION), no_sanitize("address")))
+#else
+    #define REGISTRY_SECTION ".hatreg"
+    #define REGISTRY_MARKER __attribute__((used, section(REGISTRY_SECTION)))
+#endif
+
+// A marker followed by a relative address of 0x10. Otherwise, only the elements of the signatures are in the binary.
+REGISTRY_MARKER const std::array<std::uint8_t, 20> registry_marker{
+    0x4C, 0x49, 0x42, 0x48, 0x41, 0x54, 0x5F, 0x52, 0x45, 0x47, 0x49, 0x53, 0x54, 0x52, 0x59, 0x21,
+    0x10, 0x00, 0x00, 0x00
+};
+
+inline constexpr hat::lazy_address<"4C 49 42 48 41 54 5F 52 45 47 49 53 54 52 59 21", REGISTRY_SECTION> registry_match{};
+inline constexpr hat::lazy_address<"4C 49 42 48 41 54 5F 52 45 47 49 53 54 52 59 21", REGISTRY_SECTION, hat::rel_offset<16>> registry_target{};
+inline constexpr hat::lazy_address<"4C 49 42 48 41 54 5F 52 45 47 49 53 54 52 59 22 ? ? 00 00", REGISTRY_SECTION> registry_missing{};
+
+TEST(ProcessTest, LazyAddressResolvesRegisteredSignatures) {
+    const auto stats = hat::resolve_registered();
+    EXPECT_EQ(stats.resolved, 3);
+    EXPECT_EQ(stats.missing, 1);
+    EXPECT_EQ(hat::resolve_registered().resolved, 0);
+
+    const auto marker = reinterpret_cast<const std::byte*>(registry_marker.data());
+    EXPECT_EQ(registry_match.get(), marker);
+    EXPECT_EQ(registry_target.get(), marker + 16 + 4 + 0x10);
+    EXPECT_EQ(registry_match.as<const std::uint8_t>(), registry_marker.data());
+    EXPECT_FALSE(registry_missing);
+}
+#endif
@@ -1,6 +1,19 @@
 #include <gtest/gtest.h>
+#include <libhat/calibration.hpp>
+#include <libhat/elf_image.hpp>
+#include <libhat/module_index.hpp>
+#include <libhat/pe_image.hpp>
+#include <libhat/pointers.hpp>
+#include <libhat/rtti.hpp>
 #include <libhat/scanner.hpp>
+#include <libhat/signature_db.hpp>
+#include <libhat/signature_list.hpp>
+#include <libhat/xref.hpp>
+#include <cstring>
+#include <filesystem>
 #include <format>
+#include <fstream>
+#include <random>
 
 template<hat::detail::scan_mode Mode, size_t SignatureSize, size_t MaxBufferSize>
 struct FindPatternParameters {
@@ -83,6 +96,13 @@ using FindPatternTestTypes = ::testing::Types<
     FindPatternParameters<hat::detail::scan_mode::AVX512, 16, 256>,
     FindPatternParameters<hat::detail::scan_mode::AVX512, 32, 256>,
     FindPatternParameters<hat::detail::scan_mode::AVX512, 64, 256>,
+
+    FindPatternParameters<hat::detail::scan_mode::AVX512VL, 1, 256>,
+    FindPatternParameters<hat::detail::scan_mode::AVX512VL, 3, 256>,
+    FindPatternParameters<hat::detail::scan_mode::AVX512VL, 8, 256>,
+    FindPatternParameters<hat::detail::scan_mode::AVX512VL, 16, 256>,
+    FindPatternParameters<hat::detail::scan_mode::AVX512VL, 32, 256>,
+    FindPatternParameters<hat::detail::scan_mode::AVX512VL, 64, 256>,
 #endif
 #if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
     FindPatternParameters<hat::detail::scan_mode::Neon, 1, 256>,
@@ -92,6 +112,20 @@ using FindPatternTestTypes = ::testing::Types<
     FindPatternParameters<hat::detail::scan_mode::Neon, 32, 256>,
     FindPatternParameters<hat::detail::scan_mode::Neon, 64, 256>,
 #endif
+    FindPatternParameters<hat::detail::scan_mode::SWAR, 1, 256>,
+    FindPatternParameters<hat::detail::scan_mode::SWAR, 3, 256>,
+    FindPatternParameters<hat::detail::scan_mode::SWAR, 8, 256>,
+    FindPatternParameters<hat::detail::scan_mode::SWAR, 16, 256>,
+    FindPatternParameters<hat::detail::scan_mode::SWAR, 32, 256>,
+    FindPatternParameters<hat::detail::scan_mode::SWAR, 64, 256>,
+
+    FindPatternParameters<hat::detail::scan_mode::Horspool, 1, 256>,
+    FindPatternParameters<hat::detail::scan_mode::Horspool, 3, 256>,
+    FindPatternParameters<hat::detail::scan_mode::Horspool, 8, 256>,
+    FindPatternParameters<hat::detail::scan_mode::Horspool, 16, 256>,
+    FindPatternParameters<hat::detail::scan_mode::Horspool, 32, 256>,
+    FindPatternParameters<hat::detail::scan_mode::Horspool, 64, 256>,
+
     FindPatternParameters<hat::detail::scan_mode::Single, 1, 256>,
     FindPatternParameters<hat::detail::scan_mode::Single, 3, 256>,
     FindPatternParameters<hat::detail::scan_mode::Single, 8, 256>,
@@ -111,9 +145,12 @@ private:
     template<hat::detail::scan_mode Mode>
     static consteval std::string_view getModeName() {
         if constexpr (Mode == hat::detail::scan_mode::Single) return "Single";
+        else if constexpr (Mode == hat::detail::scan_mode::SWAR) return "SWAR";
+        else if constexpr (Mode == hat::detail::scan_mode::Horspool) return "Horspool";
         else if constexpr (Mode == hat::detail::scan_mode::SSE) return "SSE";
         else if constexpr (Mode == hat::detail::scan_mode::AVX2) return "AVX2";
         else if constexpr (Mode == hat::detail::scan_mode::AVX512) return "AVX512";
+        else if constexpr (Mode == hat::detail::scan_mode::AVX512VL) return "AVX512VL";
         else if constexpr (Mode == hat::detail::scan_mode::Neon) return "Neon";
         else static_assert(sizeof(Mode) == 0);
     }
@@ -149,3 +186,1251 @@ TYPED_TEST(FindPatternTest, ScanX16) {
         }
     });
 }
+
+TEST(FindPatternByteClassTest, Parse) {
+    const auto sig = hat::parse_signature("[48|4C] 8B [50-57]").value();
+    ASSERT_EQ(sig.size(), 3);
+    EXPECT_TRUE(sig[0] == std::byte{0x48});
+    EXPECT_TRUE(sig[0] == std::byte{0x4C});
+    EXPECT_FALSE(sig[0] == std::byte{0x49});
+    EXPECT_EQ(sig[2].mask(), std::byte{0xF8});
+    EXPECT_EQ(hat::to_string(sig), "01001?00 8B 01010???");
+    EXPECT_EQ(hat::to_string(hat::parse_signature(hat::to_string(sig)).value()), hat::to_string(sig));
+
+    // Not a single masked value, which only a class_signature can hold
+    EXPECT_EQ(hat::parse_signature("8B [4?|E8]").error(), hat::signature_error::element_parse_error);
+    EXPECT_EQ(hat::parse_signature("8B [41-5A]").error(), hat::signature_error::element_parse_error);
+    EXPECT_EQ(hat::parse_signature("[50-57] [48|4C]").error(), hat::signature_error::missing_masked_byte);
+    EXPECT_FALSE(hat::parse_signature("[01|02|04]").has_value());
+    EXPECT_FALSE(hat::parse_signature("[57-50]").has_value());
+    EXPECT_FALSE(hat::parse_signature("[5-7]").has_value());
+    EXPECT_FALSE(hat::parse_signature("[48|]").has_value());
+
+#ifdef LIBHAT_HAS_CONSTEXPR_RESULT
+    using namespace hat::literals;
+    static_assert(hat::to_string("[48|4C] [50-57] 8B"_sig) == "01001?00 01010??? 8B");
+#endif
+}
+
+TEST(FindPatternByteClassTest, ParseAlternatives) {
+    const auto sig = hat::parse_class_signature("[48|4C] 8B [4?|E8] [50-57]").value();
+    ASSERT_EQ(sig.elements.size(), 4);
+    ASSERT_EQ(sig.classes.size(), 1);
+    EXPECT_EQ(sig.classes[0].index, 2);
+    for (int b = 0; b < 256; b++) {
+        EXPECT_EQ(sig.classes[0] == std::byte(b), (b & 0xF0) == 0x40 || b == 0xE8);
+        // The element encloses the class
+        if (sig.classes[0] == std::byte(b)) {
+            EXPECT_TRUE(sig.elements[2] == std::byte(b));
+        }
+    }
+    EXPECT_EQ(hat::to_string(sig), "01001?00 8B [40-4F|E8] 01010???");
+    EXPECT_EQ(hat::to_string(hat::parse_class_signature(hat::to_string(sig)).value()), hat::to_string(sig));
+    EXPECT_EQ(sizeof(hat::signature_element), 2);
+}
+
+TEST(FindPatternByteClassTest, ParseRanges) {
+    // Classes of any shape are accepted, not only those fitting in a few masked values
+    for (const auto& [str, lo, hi] : {
+        std::tuple{"[41-5A]", 0x41, 0x5A},
+        std::tuple{"[50-5A]", 0x50, 0x5A},
+        std::tuple{"[30-39]", 0x30, 0x39},
+        std::tuple{"[00-FE]", 0x00, 0xFE},
+    }) {
+        const auto sig = hat::parse_class_signature(std::string{"8B "} + str).value();
+        ASSERT_EQ(sig.classes.size(), 1);
+        for (int b = 0; b < 256; b++) {
+            EXPECT_EQ(sig.classes[0] == std::byte(b), b >= lo && b <= hi) << str;
+            if (b >= lo && b <= hi) {
+                EXPECT_TRUE(sig.elements[1] == std::byte(b));
+            }
+        }
+        EXPECT_EQ(hat::to_string(sig), std::string{"8B "} + str);
+    }
+
+    const auto sig = hat::parse_class_signature("[01|02|04] 8B [30-39|41-46]").value();
+    ASSERT_EQ(sig.classes.size(), 2);
+    EXPECT_EQ(hat::to_string(sig), "[01-02|04] 8B [30-39|41-46]");
+    EXPECT_TRUE(sig.classes[1] == std::byte{0x35});
+    EXPECT_FALSE(sig.classes[1] == std::byte{0x3A});
+    EXPECT_FALSE(sig.classes[1] == std::byte{0x40});
+    EXPECT_TRUE(sig.classes[1] == std::byte{0x46});
+}
+
+TEST(FindPatternByteClassTest, ScanAlternatives) {
+    const auto sig = hat::parse_class_signature("8B [4?|E8] C3").value();
+
+    std::vector code(256, std::byte{0x00});
+    auto* const begin = std::to_address(code.begin());
+    // Matches the enclosing masked value, but not the class
+    begin[10] = std::byte{0x8B}; begin[11] = std::byte{0x68}; begin[12] = std::byte{0xC3};
+    EXPECT_FALSE(hat::find_pattern(code, sig).has_result());
+
+    begin[100] = std::byte{0x8B}; begin[101] = std::byte{0xE8}; begin[102] = std::byte{0xC3};
+    EXPECT_EQ(hat::find_pattern(code, sig).get(), begin + 100);
+    begin[50] = std::byte{0x8B}; begin[51] = std::byte{0x4D}; begin[52] = std::byte{0xC3};
+    EXPECT_EQ(hat::find_pattern(code, sig).get(), begin + 50);
+
+    // 0x3A to 0x3F share the enclosing masked value 0011???? with the range, and are rejected by the class
+    const auto range = hat::parse_class_signature("E8 [30-39] C3").value();
+    for (int b = 0x3A; b <= 0x3F; b++) {
+        const auto at = 150 + (b - 0x3A) * 4;
+        begin[at] = std::byte{0xE8}; begin[at + 1] = std::byte(b); begin[at + 2] = std::byte{0xC3};
+    }
+    EXPECT_FALSE(hat::find_pattern(std::span{code}.subspan(150), range).has_result());
+    begin[200] = std::byte{0xE8}; begin[201] = std::byte{0x37}; begin[202] = std::byte{0xC3};
+    EXPECT_EQ(hat::find_pattern(std::span{code}.subspan(150), range).get(), begin + 200);
+}
+
+TEST(FindPatternByteClassTest, ClassAnchor) {
+    // Without a fully masked byte, the scanner anchors on the most selective masked element
+    const hat::signature sig{
+        hat::signature_element{std::byte{0x50}, std::byte{0xF8}},
+        hat::signature_element{std::byte{0x48}, std::byte{0xFB}},
+        hat::signature_element{std::byte{0x80}, std::byte{0xF0}},
+    };
+
+    std::vector code(256, std::byte{0x00});
+    auto* const begin = std::to_address(code.begin());
+    begin[10] = std::byte{0x53}; begin[11] = std::byte{0x49}; begin[12] = std::byte{0x89};
+    EXPECT_FALSE(hat::find_pattern(code, sig).has_result());
+
+    begin[100] = std::byte{0x55}; begin[101] = std::byte{0x4C}; begin[102] = std::byte{0x8B};
+    EXPECT_EQ(hat::find_pattern(code, sig).get(), begin + 100);
+}
+
+TEST(FindPatternAdaptiveTest, Padding) {
+    const auto sig = hat::parse_signature("CC CC 48 8B 05 ? ? ? ? CC").value();
+
+    // Large enough for the vectorized scanners to switch anchors several blocks before the match
+    std::vector code(1 << 16, std::byte{0xCC});
+    auto* const begin = std::to_address(code.begin());
+    auto* const end = std::to_address(code.end());
+
+    const auto check = [&]<hat::detail::scan_mode Mode>() {
+        for (const auto alignment : {hat::scan_alignment::X1, hat::scan_alignment::X16}) {
+            const auto fixed = hat::detail::scan_context::create<Mode>(sig, alignment, hat::scan_hint::none);
+            auto adaptive = hat::detail::scan_context::create<Mode>(sig, alignment, hat::scan_hint::adaptive_anchor);
+            EXPECT_FALSE(fixed.adaptive);
+
+            std::ranges::fill(code, std::byte{0xCC});
+            EXPECT_FALSE(adaptive.scan(begin, end).has_result());
+
+            for (const std::size_t offset : {std::size_t{40000}, std::size_t{40001}, std::size_t{40016}, code.size() - sig.size()}) {
+                std::ranges::fill(code, std::byte{0xCC});
+                begin[offset + 2] = std::byte{0x48}; begin[offset + 3] = std::byte{0x8B}; begin[offset + 4] = std::byte{0x05};
+#ifdef LIBHAT_SCAN_STATS
+                hat::scan_stats stats{};
+                adaptive.stats = &stats;
+#endif
+                const auto result = adaptive.scan(begin, end);
+#ifdef LIBHAT_SCAN_STATS
+                adaptive.stats = nullptr;
+#endif
+                EXPECT_EQ(result.get(), fixed.scan(begin, end).get());
+                if (alignment != hat::scan_alignment::X1) {
+                    // Only one position in 16 is a candidate, which doesn't exceed the threshold for switching anchors
+                    continue;
+                }
+                EXPECT_EQ(result.get(), begin + offset);
+#ifdef LIBHAT_SCAN_STATS
+                if constexpr (Mode != hat::detail::scan_mode::Single && Mode != hat::detail::scan_mode::Horspool) {
+                    EXPECT_TRUE(stats.reanchored);
+                }
+#endif
+            }
+        }
+    };
+#if defined(LIBHAT_X86_64) || defined(LIBHAT_X86)
+    check.template operator()<hat::detail::scan_mode::SSE>();
+    check.template operator()<hat::detail::scan_mode::AVX2>();
+#endif
+#ifdef LIBHAT_X86_64
+    check.template operator()<hat::detail::scan_mode::AVX512>();
+    check.template operator()<hat::detail::scan_mode::AVX512VL>();
+#endif
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+    check.template operator()<hat::detail::scan_mode::Neon>();
+#endif
+    check.template operator()<hat::detail::scan_mode::SWAR>();
+    check.template operator()<hat::detail::scan_mode::Horspool>();
+    check.template operator()<hat::detail::scan_mode::Single>();
+
+    // The hint is also honored when the scanner is picked at runtime
+    begin[40002] = std::byte{0x48}; begin[40003] = std::byte{0x8B}; begin[40004] = std::byte{0x05};
+    EXPECT_EQ(hat::find_pattern(begin, end, sig, hat::scan_alignment::X1, hat::scan_hint::adaptive_anchor).get(), begin + 40000);
+    EXPECT_EQ(hat::find_pattern(begin, end, sig, hat::scan_alignment::X1, hat::scan_hint::x86_64 | hat::scan_hint::adaptive_anchor).get(), begin + 40000);
+}
+
+#ifdef LIBHAT_SCAN_STATS
+TEST(FindPatternStatsTest, Counters) {
+    const auto sig = hat::parse_signature("01 02 03 04").value();
+    std::vector code(4096, std::byte{0x00});
+    auto* const begin = std::to_address(code.begin());
+    for (std::size_t i = 0; i < code.size(); i += 64) {
+        begin[i] = std::byte{0x01}; begin[i + 1] = std::byte{0x02};
+    }
+    begin[3000] = std::byte{0x01}; begin[3001] = std::byte{0x02}; begin[3002] = std::byte{0x03}; begin[3003] = std::byte{0x04};
+
+    hat::scan_stats stats{};
+    EXPECT_EQ(hat::find_pattern(code, sig, stats).get(), begin + 3000);
+    EXPECT_TRUE(stats.found);
+    EXPECT_FALSE(stats.kernel.empty());
+    EXPECT_EQ(stats.anchor_index, 0);
+    // Every "01 02" before the match is a false positive, the scalar head may check the first position again
+    EXPECT_GE(stats.candidates, 3000 / 64 + 1 + 1);
+    EXPECT_LE(stats.candidates, 3000 / 64 + 1 + 2);
+    EXPECT_GT(stats.false_positive_rate(), 0.9);
+
+    EXPECT_EQ(hat::find_pattern(begin, begin + 100, sig, stats).get(), nullptr);
+    EXPECT_FALSE(stats.found);
+    EXPECT_GE(stats.candidates, 2);
+    EXPECT_EQ(stats.false_positive_rate(), 1.0);
+}
+#endif
+
+/// Restores the preferred scan modes when a test which changes them ends, even if it fails early
+class preferred_scan_mode_guard {
+public:
+    preferred_scan_mode_guard() {
+        for (std::size_t i = 0; i < hat::scan_size_class_count; i++) {
+            this->modes[i] = hat::get_preferred_scan_mode(static_cast<hat::scan_size_class>(i));
+        }
+    }
+
+    preferred_scan_mode_guard(const preferred_scan_mode_guard&) = delete;
+    preferred_scan_mode_guard& operator=(const preferred_scan_mode_guard&) = delete;
+
+    ~preferred_scan_mode_guard() {
+        for (std::size_t i = 0; i < hat::scan_size_class_count; i++) {
+            hat::set_preferred_scan_mode(static_cast<hat::scan_size_class>(i), this->modes[i]);
+        }
+    }
+
+private:
+    std::array<hat::scan_mode, hat::scan_size_class_count> modes{};
+};
+
+TEST(ScanModeTest, PreferredMode) {
+    const preferred_scan_mode_guard guard{};
+    EXPECT_TRUE(hat::is_scan_mode_supported(hat::scan_mode::Single));
+    EXPECT_TRUE(hat::is_scan_mode_supported(hat::get_default_scan_mode()));
+
+    const auto sig = hat::parse_signature("01 02 03 04").value();
+    std::vector code(1 << 22, std::byte{0x00});
+    auto* const begin = std::to_address(code.begin());
+    begin[100] = std::byte{0x01}; begin[101] = std::byte{0x02}; begin[102] = std::byte{0x03}; begin[103] = std::byte{0x04};
+
+    // Different scanners for small and large buffers
+    ASSERT_TRUE(hat::set_preferred_scan_mode(hat::scan_size_class::small, hat::scan_mode::Single));
+    EXPECT_EQ(hat::get_preferred_scan_mode(hat::scan_size_class::small), hat::scan_mode::Single);
+    EXPECT_EQ(hat::get_preferred_scan_mode(hat::scan_size_class::large), hat::scan_mode::Auto);
+    EXPECT_EQ(hat::find_pattern(begin, begin + 1024, sig).get(), begin + 100);
+    EXPECT_EQ(hat::find_pattern(code, sig).get(), begin + 100);
+
+    ASSERT_TRUE(hat::set_preferred_scan_mode(hat::scan_mode::Auto));
+    EXPECT_EQ(hat::get_preferred_scan_mode(hat::scan_size_class::small), hat::scan_mode::Auto);
+
+    // A long run of known bytes still selects Horspool over the preferred mode
+    ASSERT_TRUE(hat::set_preferred_scan_mode(hat::scan_mode::Single));
+    std::vector<std::byte> run(64);
+    for (std::size_t i = 0; i < run.size(); i++) {
+        run[i] = static_cast<std::byte>(i + 1);
+    }
+    const auto longSig = hat::bytes_to_signature(run).value();
+    const auto longContext = hat::detail::scan_context::create(longSig, hat::scan_alignment::X1, hat::scan_hint::none);
+    EXPECT_EQ(longContext.scanner, &hat::detail::find_pattern_horspool<hat::scan_alignment::X1>);
+    const auto shortContext = hat::detail::scan_context::create(sig, hat::scan_alignment::X1, hat::scan_hint::none);
+    EXPECT_NE(shortContext.scanner, &hat::detail::find_pattern_horspool<hat::scan_alignment::X1>);
+}
+
+TEST(ScanModeTest, Calibration) {
+    // Only checks the plumbing, so a small amount of data per measurement is enough
+    const auto calibration = hat::calibrate_scan_modes(std::size_t{64} << 10);
+    for (const auto mode : calibration.modes) {
+        EXPECT_TRUE(hat::is_scan_mode_supported(mode));
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "libhat_test_calibration.txt";
+    if (calibration.cpu.empty()) {
+        // Calibrations of hosts which can't be identified aren't cached
+        EXPECT_FALSE(hat::save_scan_calibration(calibration, path));
+        EXPECT_FALSE(std::filesystem::exists(path));
+        return;
+    }
+    ASSERT_TRUE(hat::save_scan_calibration(calibration, path));
+    const auto loaded = hat::load_scan_calibration(path);
+    std::filesystem::remove(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->cpu, calibration.cpu);
+    EXPECT_EQ(loaded->modes, calibration.modes);
+    EXPECT_FALSE(hat::load_scan_calibration(path).has_value());
+
+    // A calibration made on another CPU is ignored
+    auto other = calibration;
+    other.cpu += " (other)";
+    ASSERT_TRUE(hat::save_scan_calibration(other, path));
+    EXPECT_FALSE(hat::load_scan_calibration(path).has_value());
+    std::filesystem::remove(path);
+}
+
+TEST(FindPatternFuzzyTest, ToleratesMismatches) {
+    const auto sig = hat::parse_signature("48 8B 05 ? ? ? ? 48 85 C0 74 10 E8 ? ? ? ? 90").value();
+
+    std::vector code(512, std::byte{0xCC});
+    auto* const begin = std::to_address(code.begin());
+    auto* const target = begin + 300;
+    std::ranges::copy(sig | std::views::transform(&hat::signature_element::value), target);
+    target[1] = std::byte{0x8D};
+    target[10] = std::byte{0x75};
+
+    EXPECT_FALSE(hat::find_pattern(code, sig).has_result());
+    EXPECT_FALSE(hat::find_pattern_fuzzy(code, sig, 1).has_result());
+
+    for (size_t k = 2; k <= 4; k++) {
+        const auto result = hat::find_pattern_fuzzy(code, sig, k);
+        ASSERT_TRUE(result.has_result());
+        EXPECT_EQ(result.result.get(), target);
+        EXPECT_EQ(result.mismatches, 2);
+    }
+}
+
+TEST(FindPatternFuzzyTest, PrefersFewestMismatches) {
+    const auto sig = hat::parse_signature("01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F 10 11 12 13 14 15 16 17 18 19 1A 1B 1C 1D 1E 1F 20 21 22 23").value();
+
+    std::vector code(1024, std::byte{0x00});
+    auto* const begin = std::to_address(code.begin());
+    for (const size_t offset : {100, 400, 700}) {
+        std::ranges::copy(sig | std::views::transform(&hat::signature_element::value), begin + offset);
+    }
+    begin[100 + 3] = begin[100 + 20] = begin[100 + 33] = std::byte{0xFF};
+    begin[400 + 7] = std::byte{0xFF};
+    begin[700 + 2] = begin[700 + 34] = std::byte{0xFF};
+
+    const auto result = hat::find_pattern_fuzzy(code, sig, 3);
+    ASSERT_TRUE(result.has_result());
+    EXPECT_EQ(result.result.get(), begin + 400);
+    EXPECT_EQ(result.mismatches, 1);
+
+    begin[400 + 7] = std::byte{0x08};
+    const auto exact = hat::find_pattern_fuzzy(code, sig, 3);
+    EXPECT_EQ(exact.result.get(), begin + 400);
+    EXPECT_EQ(exact.mismatches, 0);
+}
+
+TEST(FindPatternFuzzyTest, FewAnchors) {
+    const auto sig = hat::parse_signature("AA ? ? BB").value();
+
+    std::vector code(64, std::byte{0x00});
+    code[20] = std::byte{0xAA};
+    code[23] = std::byte{0xBC};
+
+    // With k = 1, each of the two fully masked elements is its own pigeonhole partition
+    EXPECT_EQ(hat::find_pattern_fuzzy(code, sig, 1).result.get(), code.data() + 20);
+
+    // With k = 2, there are fewer fully masked elements than pigeonhole partitions
+    const auto result = hat::find_pattern_fuzzy(code, sig, 2);
+    ASSERT_TRUE(result.has_result());
+    EXPECT_EQ(result.result.get(), code.data() + 20);
+    EXPECT_EQ(result.mismatches, 1);
+}
+
+TEST(FindPatternCompositeTest, ParseGaps) {
+    const auto composite = hat::parse_composite_signature("48 8B 05 [4-12] E8 [2] C3 [~16] CC CC").value();
+    const auto components = composite.components();
+    ASSERT_EQ(components.size(), 4);
+    EXPECT_EQ(components[1].min_offset, 3 + 4);
+    EXPECT_EQ(components[1].max_offset, 3 + 12);
+    EXPECT_EQ(components[2].min_offset, 1 + 2);
+    EXPECT_EQ(components[2].max_offset, 1 + 2);
+    EXPECT_EQ(components[3].min_offset, -16);
+    EXPECT_EQ(components[3].max_offset, 16);
+
+    EXPECT_FALSE(hat::parse_composite_signature("[4] 48").has_value());
+    EXPECT_FALSE(hat::parse_composite_signature("48 [4] [5] E8").has_value());
+    EXPECT_FALSE(hat::parse_composite_signature("48 [5-4] E8").has_value());
+    EXPECT_FALSE(hat::parse_composite_signature("48 [~4-5] E8").has_value());
+
+    // Valid as both a gap and a byte class
+    EXPECT_FALSE(hat::parse_composite_signature("48 [10-20] E8").has_value());
+    EXPECT_FALSE(hat::parse_composite_signature("48 [12] E8").has_value());
+    const auto unambiguous = hat::parse_composite_signature("48 [010-020] [01010???] E8").value();
+    ASSERT_EQ(unambiguous.size(), 2);
+    EXPECT_EQ(unambiguous.components()[1].min_offset, 1 + 10);
+    EXPECT_EQ(unambiguous.components()[1].max_offset, 1 + 20);
+    EXPECT_EQ(unambiguous.components()[1].elements[0].mask(), std::byte{0xF8});
+}
+
+TEST(FindPatternCompositeTest, ScanGaps) {
+    const auto composite = hat::parse_composite_signature("48 8B 05 [4-12] E8 ? ? ? ? [~32] 0F 0B").value();
+
+    std::vector code(512, std::byte{0x90});
+    auto* const begin = std::to_address(code.begin());
+
+    // Gap too large, shouldn't match
+    begin[16] = std::byte{0x48}; begin[17] = std::byte{0x8B}; begin[18] = std::byte{0x05};
+    begin[32] = std::byte{0xE8};
+    begin[40] = std::byte{0x0F}; begin[41] = std::byte{0x0B};
+    EXPECT_FALSE(hat::find_pattern(code, composite).has_result());
+
+    // Matching gap, but the trailing component is out of range
+    begin[100] = std::byte{0x48}; begin[101] = std::byte{0x8B}; begin[102] = std::byte{0x05};
+    begin[110] = std::byte{0xE8};
+    begin[200] = std::byte{0x0F}; begin[201] = std::byte{0x0B};
+    EXPECT_FALSE(hat::find_pattern(code, composite).has_result());
+
+    // Trailing component before the previous component, within range
+    begin[90] = std::byte{0x0F}; begin[91] = std::byte{0x0B};
+    EXPECT_EQ(hat::find_pattern(code, composite).get(), begin + 100);
+
+    hat::composite_signature built{};
+    built.append(hat::parse_signature("48 8B 05").value(), 0, 0)
+         .append_after(hat::parse_signature("E8").value(), 4, 12)
+         .append_near(hat::parse_signature("0F 0B").value(), 32);
+    EXPECT_EQ(hat::find_pattern(code, built).get(), begin + 100);
+}
+
+TEST(FindPatternCompositeTest, LowestMatch) {
+    // The middle component is the most selective, so the search is anchored on it and has to look back for the rest
+    hat::composite_signature composite{};
+    composite.append(hat::parse_signature("01 02").value(), 0, 0)
+             .append(hat::parse_signature("03 00 02").value(), -6, 9)
+             .append(hat::parse_signature("02 01").value(), 2, 7);
+    const auto components = composite.components();
+
+    // Reference: every start of the first component in order, with a depth first search for the others
+    const auto brute = [&](const std::span<const std::byte> data, const hat::scan_alignment alignment) -> const std::byte* {
+        const auto fits = [&](const std::size_t index, const std::ptrdiff_t offset) {
+            const auto& elements = components[index].elements;
+            return offset >= 0 && static_cast<std::size_t>(offset) + elements.size() <= data.size()
+                && std::equal(elements.begin(), elements.end(), data.begin() + offset);
+        };
+        const auto chain = [&](const auto& self, const std::size_t index, const std::ptrdiff_t offset) -> bool {
+            if (index + 1 == components.size()) {
+                return true;
+            }
+            for (auto next = offset + components[index + 1].min_offset; next <= offset + components[index + 1].max_offset; next++) {
+                if (fits(index + 1, next) && self(self, index + 1, next)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        for (std::ptrdiff_t offset = 0; offset < std::ssize(data); offset++) {
+            if (reinterpret_cast<std::uintptr_t>(data.data() + offset) % static_cast<std::size_t>(alignment) == 0
+                && fits(0, offset) && chain(chain, 0, offset)) {
+                return data.data() + offset;
+            }
+        }
+        return nullptr;
+    };
+
+    std::minstd_rand rng{7};
+    std::vector<std::byte> code(1024);
+    std::size_t matched{};
+    for (std::size_t round = 0; round < 64; round++) {
+        // A small alphabet, so that every component occurs often
+        std::ranges::generate(code, [&] { return static_cast<std::byte>(rng() % 4); });
+        for (const auto alignment : {hat::scan_alignment::X1, hat::scan_alignment::X4}) {
+            const auto expected = brute(code, alignment);
+            EXPECT_EQ(hat::find_pattern(code, composite, alignment).get(), expected) << "round " << round;
+            matched += expected != nullptr;
+        }
+    }
+    EXPECT_GT(matched, 0);
+}
+
+TEST(FindPatternCompositeTest, ManyComponents) {
+    // Every chain of zeros fits until the last component, which doesn't occur. Following each chain separately would
+    // take 3^20 steps per anchor match.
+    hat::composite_signature composite{};
+    composite.append(hat::parse_signature("00 00 00").value(), 0, 0);
+    for (std::size_t i = 0; i < 20; i++) {
+        composite.append(hat::parse_signature("00").value(), 1, 3);
+    }
+    composite.append(hat::parse_signature("FF").value(), 1, 3);
+
+    std::vector code(1024, std::byte{0x00});
+    EXPECT_FALSE(hat::find_pattern(code, composite).has_result());
+
+    code[800] = std::byte{0xFF};
+    EXPECT_EQ(hat::find_pattern(code, composite).get(), code.data() + 800 - 21 * 3);
+}
+
+TEST(SignatureDbTest, RoundTrip) {
+    const std::array<hat::signature_db_source, 3> sources{{
+        {.name = "world", .signature = "48 8B 05 ? ? ? ? 48 85 C0", .section = ".text", .hints = hat::scan_hint::x86_64},
+        {.name = "alpha", .signature = "[48|4C] 8D 0D ? ? ? ?", .section = ".text", .alignment = hat::scan_alignment::X16},
+        {.name = "config", .signature = "01 02 ?3 04", .section = ".rdata"},
+    }};
+    const auto compiled = hat::compile_signature_db(sources);
+    ASSERT_TRUE(compiled.has_value());
+
+    const auto path = std::filesystem::temp_directory_path() / "libhat_test_signatures.bin";
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char*>(compiled.value().data()), static_cast<std::streamsize>(compiled.value().size()));
+    }
+    const auto db = hat::signature_db::open(path);
+    std::filesystem::remove(path);
+    ASSERT_TRUE(db.has_value());
+    ASSERT_EQ(db->size(), sources.size());
+
+    // Sorted by name
+    EXPECT_EQ((*db)[0].name, "alpha");
+    EXPECT_EQ((*db)[1].name, "config");
+    EXPECT_EQ((*db)[2].name, "world");
+
+    for (const auto& source : sources) {
+        const auto entry = db->find(source.name);
+        ASSERT_TRUE(entry.has_value());
+        const auto parsed = hat::parse_signature(source.signature).value();
+        EXPECT_TRUE(std::ranges::equal(entry->signature, parsed, [](const auto& a, const auto& b) { return (a <=> b) == 0; }));
+        EXPECT_EQ(entry->section, source.section);
+        EXPECT_EQ(entry->alignment, source.alignment);
+        EXPECT_EQ(entry->hints, source.hints);
+    }
+    EXPECT_FALSE(db->find("missing").has_value());
+    EXPECT_EQ(db->requests().size(), sources.size());
+}
+
+TEST(SignatureDbTest, RejectsInvalidData) {
+    const std::array<hat::signature_db_source, 2> sources{{
+        {.name = "valid", .signature = "01 02"},
+        {.name = "invalid", .signature = "01 0"},
+    }};
+    const auto compiled = hat::compile_signature_db(sources);
+    ASSERT_FALSE(compiled.has_value());
+    EXPECT_EQ(compiled.error().index, 1);
+
+    auto data = hat::compile_signature_db(std::span{sources}.first(1)).value();
+    EXPECT_TRUE(hat::signature_db::from_bytes(data).has_value());
+    EXPECT_FALSE(hat::signature_db::from_bytes(std::span{data}.first(data.size() - 1)).has_value());
+    data[0] = std::byte{'x'};
+    EXPECT_FALSE(hat::signature_db::from_bytes(data).has_value());
+}
+
+TEST(SignatureDbTest, RejectsCorruptFiles) {
+    const std::array<hat::signature_db_source, 1> sources{{
+        {.name = "valid", .signature = "01 02 ?3"},
+    }};
+    const auto compiled = hat::compile_signature_db(sources).value();
+
+    // The single record follows the 16 byte header, its element offset and count are at +16 and +20
+    std::uint32_t elementsOffset{};
+    std::memcpy(&elementsOffset, compiled.data() + 16 + 16, sizeof(elementsOffset));
+
+    const auto open = [](const std::vector<std::byte>& data) {
+        const auto path = std::filesystem::temp_directory_path() / "libhat_test_corrupt.bin";
+        {
+            std::ofstream file{path, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+        auto db = hat::signature_db::open(path);
+        std::filesystem::remove(path);
+        return db;
+    };
+    EXPECT_TRUE(open(compiled).has_value());
+
+    auto empty = compiled;
+    const std::uint32_t zero{};
+    std::memcpy(empty.data() + 16 + 20, &zero, sizeof(zero));
+    EXPECT_FALSE(open(empty).has_value());
+
+    // "?1 ?2 ?3" has no fully masked byte to anchor on
+    auto unanchored = compiled;
+    for (std::size_t i = 0; i < 2; i++) {
+        unanchored[elementsOffset + i * 2] &= std::byte{0x0F};
+        unanchored[elementsOffset + i * 2 + 1] = std::byte{0x0F};
+    }
+    EXPECT_FALSE(open(unanchored).has_value());
+}
+
+TEST(SmallSignatureTest, StaysInline) {
+    const auto text = "48 8B 05 ? ? ? ? [48|4C] 85 C0";
+    const auto small = hat::parse_signature<>(text);
+    ASSERT_TRUE(small.has_value());
+    EXPECT_TRUE(small.value().is_inline());
+
+    const auto regular = hat::parse_signature(text).value();
+    const hat::signature_view view = small.value();
+    ASSERT_EQ(view.size(), regular.size());
+    EXPECT_TRUE(std::ranges::equal(view, regular, [](const auto& a, const auto& b) { return (a <=> b) == 0; }));
+
+    std::array<std::byte, 32> buffer{};
+    const std::array<std::byte, 10> match{
+        std::byte{0x48}, std::byte{0x8B}, std::byte{0x05}, {}, {}, {}, {}, std::byte{0x4C}, std::byte{0x85}, std::byte{0xC0}
+    };
+    std::ranges::copy(match, buffer.begin() + 7);
+    EXPECT_EQ(hat::find_pattern(buffer, small.value()).get(), buffer.data() + 7);
+
+    EXPECT_FALSE(hat::parse_signature<>("01 0").has_value());
+    EXPECT_EQ(hat::string_to_signature<16>(std::string_view{"abc"}).value().size(), 3);
+}
+
+TEST(SmallSignatureTest, SpillsToHeap) {
+    hat::small_signature<4> sig{};
+    for (std::uint8_t i = 0; i < 4; i++) {
+        sig.emplace_back(std::byte{i});
+    }
+    EXPECT_TRUE(sig.is_inline());
+    sig.emplace_back(std::byte{4});
+    EXPECT_FALSE(sig.is_inline());
+    ASSERT_EQ(sig.size(), 5);
+    for (std::uint8_t i = 0; i < 5; i++) {
+        EXPECT_EQ(sig[i].value(), std::byte{i});
+    }
+
+    const auto copy = sig;
+    EXPECT_EQ(copy.size(), 5);
+    EXPECT_EQ(copy[4].value(), std::byte{4});
+
+    const auto parsed = hat::parse_signature<4>("01 02 03 04 05 06");
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_FALSE(parsed.value().is_inline());
+    EXPECT_EQ(parsed.value().size(), 6);
+}
+
+TEST(PackedSignatureTest, Layout) {
+    const auto sig = hat::parse_signature("48 ? 01010??? [4?|4C] 8B").value();
+    const hat::packed_signature packed{sig};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&packed) % 64, 0);
+    EXPECT_EQ(packed.size, 5);
+    EXPECT_EQ(packed.known, 0b10001u);
+    EXPECT_EQ(packed.values[0], std::byte{0x48});
+    EXPECT_EQ(packed.masks[1], std::byte{0x00});
+    EXPECT_EQ(packed.masks[2], std::byte{0xF8});
+    EXPECT_EQ(packed.values[3], std::byte{0x40});
+    EXPECT_EQ(packed.masks[3], std::byte{0xF0});
+
+    // Padding matches any byte
+    EXPECT_EQ(packed.masks[5], std::byte{0x00});
+    EXPECT_EQ(packed.masks[63], std::byte{0x00});
+}
+
+TEST(PackedSignatureTest, LongSignature) {
+    // Longer than the packed representation, with a masked byte inside it and another past its end
+    hat::signature sig{};
+    for (std::size_t i = 0; i < 96; i++) {
+        sig.emplace_back(static_cast<std::byte>(i + 1));
+    }
+    sig[40] = hat::signature_element{std::byte{0x30}, std::byte{0xF0}};
+    sig[80] = hat::signature_element{std::byte{0x50}, std::byte{0xF0}};
+
+    std::vector code(512, std::byte{0x00});
+    auto* const begin = std::to_address(code.begin());
+    auto* const match = begin + 131;
+    for (std::size_t i = 0; i < sig.size(); i++) {
+        match[i] = sig[i].value();
+    }
+    match[40] = std::byte{0x33};
+    match[80] = std::byte{0x5A};
+
+    const auto check = [&]<hat::detail::scan_mode Mode>() {
+        const auto context = hat::detail::scan_context::create<Mode>(sig, hat::scan_alignment::X1, hat::scan_hint::none);
+        EXPECT_EQ(context.scan(begin, begin + code.size()).get(), match);
+
+        match[90] = std::byte{0xFF};
+        EXPECT_FALSE(context.scan(begin, begin + code.size()).has_result());
+        match[90] = sig[90].value();
+
+        match[40] = std::byte{0x43};
+        EXPECT_FALSE(context.scan(begin, begin + code.size()).has_result());
+        match[40] = std::byte{0x33};
+    };
+#if defined(LIBHAT_X86_64) || defined(LIBHAT_X86)
+    check.template operator()<hat::detail::scan_mode::SSE>();
+    check.template operator()<hat::detail::scan_mode::AVX2>();
+#endif
+#ifdef LIBHAT_X86_64
+    check.template operator()<hat::detail::scan_mode::AVX512>();
+    check.template operator()<hat::detail::scan_mode::AVX512VL>();
+#endif
+#if defined(LIBHAT_ARM) || defined(LIBHAT_AARCH64)
+    check.template operator()<hat::detail::scan_mode::Neon>();
+#endif
+    check.template operator()<hat::detail::scan_mode::SWAR>();
+    check.template operator()<hat::detail::scan_mode::Single>();
+}
+
+TEST(SignatureListTest, MatchesParseSignature) {
+    const std::array<std::string_view, 8> lines{
+        "48 8B 05 ? ? ? ? 48 85 C0 0F 84 ?? ?? ?? ?? 48 8B 88 ? ? ? ? 48 85 C9 74 ? E8 ? ? ? ? 48 8B 5C 24 ?",
+        "e8 ?? ?? ?? ?? 4? 8b ?8",
+        "  C3   CC  ",
+        "01001??? 8B [48|4C] 05",
+        "?? 90",
+        "55",
+        "48 8D 0D ? ? ? ? E8 ? ? ? ? 48 8D 15 ? ? ? ? 48 8B C8 FF 15 ? ? ? ? 85 C0 75 ? 48 83 C4 28 C3",
+        "[50-57] 48 89 E5",
+    };
+
+    std::string text{};
+    for (const auto line : lines) {
+        text += line;
+        text += "\r\n\n";
+    }
+
+    const auto list = hat::parse_signature_list(text);
+    ASSERT_TRUE(list.has_value());
+    ASSERT_EQ(list.value().size(), lines.size());
+    for (std::size_t i = 0; i < lines.size(); i++) {
+        const auto expected = hat::parse_signature(lines[i]).value();
+        EXPECT_EQ(list.value().line(i), i * 2);
+        EXPECT_TRUE(std::ranges::equal(list.value()[i], expected, [](const auto& a, const auto& b) { return (a <=> b) == 0; }))
+            << lines[i];
+    }
+}
+
+TEST(SignatureListTest, ReportsErrors) {
+    const auto check = [](const std::string_view text, const std::size_t line, const hat::signature_error error) {
+        const auto list = hat::parse_signature_list(text);
+        ASSERT_FALSE(list.has_value()) << text;
+        EXPECT_EQ(list.error().line, line) << text;
+        EXPECT_EQ(list.error().error, error) << text;
+    };
+    check("48 8B\n48 8G\n", 1, hat::signature_error::element_parse_error);
+    check("48\n\n? ?? ?", 2, hat::signature_error::missing_masked_byte);
+    check("48 8B 1", 0, hat::signature_error::expected_wildcard);
+    check("48 8B\n48 8B 0 5", 1, hat::signature_error::expected_wildcard);
+    check("48 8B\n488B", 1, hat::signature_error::invalid_token_length);
+    check("48 8B\n48\r8B", 1, hat::signature_error::invalid_token_length);
+
+    const auto empty = hat::parse_signature_list("\n  \n");
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty.value().empty());
+}
+
+TEST(ModuleIndexTest, MatchesFindPattern) {
+    // Few distinct bytes, so that sequences repeat and the positions of the signatures need to be verified
+    std::vector<std::byte> data(1 << 18);
+    std::minstd_rand rng{42};
+    for (auto& byte : data) {
+        byte = static_cast<std::byte>(rng() % 6);
+    }
+
+    std::vector<hat::signature> signatures{};
+    for (std::size_t i = 0; i < 200; i++) {
+        const auto size = 8 + rng() % 24;
+        const auto offset = rng() % (data.size() - size);
+        hat::signature sig(data.begin() + static_cast<std::ptrdiff_t>(offset), data.begin() + static_cast<std::ptrdiff_t>(offset + size));
+        sig[rng() % size] = std::nullopt;
+        if (i % 4 == 0) {
+            sig[rng() % size] = std::byte{0xFF}; // Not in the data
+        }
+        signatures.push_back(std::move(sig));
+    }
+
+    for (const std::size_t budget : {std::size_t{0}, data.size()}) {
+        const hat::module_index index{data, {.memory_budget = budget}};
+        if (budget) {
+            EXPECT_GT(index.stride(), 1);
+            EXPECT_LE(index.memory_usage(), budget);
+        } else {
+            EXPECT_EQ(index.stride(), 1);
+        }
+
+        for (const auto& sig : signatures) {
+            for (const auto alignment : {hat::scan_alignment::X1, hat::scan_alignment::X4}) {
+                const auto expected = hat::find_pattern(std::as_const(data), sig, alignment);
+                EXPECT_EQ(index.find_pattern(sig, alignment).get(), expected.get());
+            }
+        }
+    }
+}
+
+TEST(XrefTest, MatchesBruteForce) {
+    std::vector<std::byte> data((1 << 16) + 13);
+    std::minstd_rand rng{42};
+    for (auto& byte : data) {
+        byte = static_cast<std::byte>(rng());
+    }
+
+    const auto base = reinterpret_cast<std::uintptr_t>(data.data());
+    std::vector<std::uintptr_t> targets{base + 100, base + 0x8000, base + data.size() + 0x100000};
+    for (std::size_t i = 0; i < 5; i++) {
+        targets.push_back(base + rng() % data.size());
+    }
+    std::ranges::sort(targets);
+
+    // Plant the instructions of every kind, including at both ends of the data
+    const std::vector<std::vector<std::uint8_t>> opcodes{
+        {0xE8}, {0xE9}, {0x0F, 0x84}, {0x48, 0x8D, 0x05}, {0x8D, 0x0D}, {0x4C, 0x8B, 0x3D}, {0x89, 0x1D}, {0xFF, 0x15}, {0xFF, 0x25}
+    };
+    const auto plant = [&](const std::size_t offset, const std::vector<std::uint8_t>& opcode, const std::uintptr_t target) {
+        std::ranges::transform(opcode, data.begin() + static_cast<std::ptrdiff_t>(offset), [](const auto b) { return std::byte{b}; });
+        const auto pos = offset + opcode.size();
+        const auto disp = static_cast<std::int32_t>(target - (base + pos + 4));
+        std::memcpy(data.data() + pos, &disp, sizeof(disp));
+    };
+    plant(0, opcodes[0], targets[0]);
+    plant(data.size() - 7, opcodes[3], targets[1]);
+    for (std::size_t i = 0; i < 500; i++) {
+        plant(8 + rng() % (data.size() - 24), opcodes[rng() % opcodes.size()], targets[rng() % targets.size()]);
+    }
+
+    const auto brute_force = [&](const std::uintptr_t target) {
+        std::vector<std::size_t> positions{};
+        for (std::size_t pos = 1; pos + 4 <= data.size(); pos++) {
+            std::int32_t disp;
+            std::memcpy(&disp, data.data() + pos, sizeof(disp));
+            if (base + pos + 4 + static_cast<std::uintptr_t>(static_cast<std::intptr_t>(disp)) != target) {
+                continue;
+            }
+            const auto b1 = std::to_integer<std::uint8_t>(data[pos - 1]);
+            const auto b2 = pos >= 2 ? std::to_integer<std::uint8_t>(data[pos - 2]) : 0;
+            const bool rel = b1 == 0xE8 || b1 == 0xE9 || (b2 == 0x0F && b1 >= 0x80 && b1 <= 0x8F);
+            const bool ripRelative = (b1 & 0xC7) == 0x05 && (b2 == 0x8D || b2 == 0x8B || b2 == 0x89 || (b2 == 0xFF && (b1 == 0x15 || b1 == 0x25)));
+            if (rel || ripRelative) {
+                positions.push_back(pos);
+            }
+        }
+        return positions;
+    };
+
+    std::vector<hat::xref> all{};
+    for (const auto target : targets) {
+        const auto xrefs = hat::find_xrefs(data, target);
+        const auto expected = brute_force(target);
+        ASSERT_EQ(xrefs.size(), expected.size());
+        for (std::size_t i = 0; i < xrefs.size(); i++) {
+            EXPECT_EQ(xrefs[i].target, target);
+            EXPECT_LE(xrefs[i].instruction, data.data() + expected[i] - 1);
+            EXPECT_GE(xrefs[i].instruction, data.data() + expected[i] - 3);
+        }
+        all.insert(all.end(), xrefs.begin(), xrefs.end());
+    }
+    EXPECT_GE(all.size(), 400);
+
+    auto combined = hat::find_xrefs(data, targets);
+    std::ranges::sort(all);
+    std::ranges::sort(combined);
+    EXPECT_EQ(combined, all);
+}
+
+TEST(XrefTest, AArch64) {
+    std::vector<std::uint32_t> words((1 << 14) + 3);
+    std::minstd_rand rng{42};
+    for (auto& word : words) {
+        word = static_cast<std::uint32_t>(rng()) ^ (static_cast<std::uint32_t>(rng()) << 16);
+    }
+    const auto data = std::as_bytes(std::span{words});
+    const auto base = reinterpret_cast<std::uintptr_t>(words.data());
+
+    std::vector<std::uintptr_t> targets{base + 0x40, base + 0x8000, base + 0x4000000, base - 0x3000};
+    std::ranges::sort(targets);
+
+    const auto branch = [&](const std::size_t index, const std::uintptr_t target, const bool link) {
+        const auto offset = static_cast<std::uint32_t>((target - (base + index * 4)) / 4) & 0x3FFFFFF;
+        words[index] = (link ? 0x94000000 : 0x14000000) | offset;
+    };
+    const auto adrp = [&](const std::size_t index, const std::uintptr_t target, const std::uint32_t reg) {
+        const auto page = static_cast<std::uint32_t>(((target >> 12) - ((base + index * 4) >> 12)) & 0x1FFFFF);
+        words[index] = 0x90000000 | ((page & 3) << 29) | ((page >> 2) << 5) | reg;
+        words[index + 1] = 0xD503201F; // NOP
+    };
+
+    // Pairs with ADD, LDR X and STR W, each target with every kind
+    std::vector<std::pair<std::size_t, hat::xref_kind>> planted{};
+    std::size_t index = 1;
+    for (const auto target : targets) {
+        const auto aligned = target & ~std::uintptr_t{7};
+        const auto low = static_cast<std::uint32_t>(aligned & 0xFFF);
+        const std::uint32_t reg = 1 + static_cast<std::uint32_t>(rng() % 28);
+
+        branch(index, aligned, true);
+        planted.emplace_back(index, hat::xref_kind::bl);
+        branch(index += 16, aligned, false);
+        planted.emplace_back(index, hat::xref_kind::b);
+        adrp(index += 16, aligned, reg);
+        words[index + 2] = 0x91000000 | (low << 10) | (reg << 5) | 2;
+        planted.emplace_back(index, hat::xref_kind::adrp_add);
+        adrp(index += 16, aligned, reg);
+        words[index + 2] = 0xF9400000 | ((low / 8) << 10) | (reg << 5) | 3;
+        planted.emplace_back(index, hat::xref_kind::adrp_ldr);
+        adrp(index += 16, aligned & ~std::uintptr_t{3}, reg);
+        words[index + 2] = 0xB9000000 | ((low / 4) << 10) | (reg << 5) | 4;
+        planted.emplace_back(index, hat::xref_kind::adrp_str);
+        index += 16;
+    }
+    branch(words.size() - 1, targets[0] & ~std::uintptr_t{7}, true);
+    planted.emplace_back(words.size() - 1, hat::xref_kind::bl);
+    std::ranges::sort(planted);
+
+    std::vector<std::uintptr_t> resolvable{};
+    for (const auto target : targets) {
+        resolvable.push_back(target & ~std::uintptr_t{7});
+    }
+    std::ranges::sort(resolvable);
+
+    std::vector<hat::xref> all{};
+    for (const auto target : resolvable) {
+        const auto xrefs = hat::find_xrefs_aarch64(data, target);
+        for (const auto& xref : xrefs) {
+            EXPECT_EQ(xref.target, target);
+        }
+        all.insert(all.end(), xrefs.begin(), xrefs.end());
+    }
+    std::ranges::sort(all);
+    EXPECT_EQ(hat::find_xrefs_aarch64(data, resolvable), all);
+
+    std::vector<std::pair<std::size_t, hat::xref_kind>> found{};
+    for (const auto& xref : all) {
+        found.emplace_back(static_cast<std::size_t>(xref.instruction - data.data()) / 4, xref.kind);
+    }
+    EXPECT_EQ(found, planted);
+
+    // Unaligned data starts at the next whole instruction, skipping the first word, which has no reference
+    EXPECT_EQ(hat::find_xrefs_aarch64(data.subspan(2), resolvable), all);
+}
+
+TEST(XrefTest, AArch64Interleaved) {
+    std::vector<std::uint32_t> words(64, 0xD503201F); // NOP
+    const auto data = std::as_bytes(std::span{words});
+    const auto base = reinterpret_cast<std::uintptr_t>(words.data());
+    const auto target = (base + 0x3000) & ~std::uintptr_t{7};
+    const auto low = static_cast<std::uint32_t>(target & 0xFFF);
+
+    const auto adrp = [&](const std::size_t index, const std::uint32_t reg) {
+        const auto page = static_cast<std::uint32_t>(((target >> 12) - ((base + index * 4) >> 12)) & 0x1FFFFF);
+        words[index] = 0x90000000 | ((page & 3) << 29) | ((page >> 2) << 5) | reg;
+    };
+
+    // Instructions which don't read the page from x1 as a base, even though bits 5-9 hold 1
+    adrp(4, 1);
+    words[5] = 0xD2800022;                                // MOVZ x2, #1
+    words[6] = 0xF90007E1;                                // STR x1, [sp, #8]
+    words[7] = 0xF9400BE2;                                // LDR x2, [sp, #16]
+    words[8] = 0x91000000 | (low << 10) | (1 << 5) | 0;   // ADD x0, x1, #low
+
+    // x1 is overwritten before the ADD
+    adrp(16, 1);
+    words[17] = 0xAA0503E1;                               // MOV x1, x5
+    words[18] = 0x91000000 | (low << 10) | (1 << 5) | 0;  // ADD x0, x1, #low
+
+    // x3 is written back by a post-indexed load before the LDR
+    adrp(28, 3);
+    words[29] = 0xF8408464;                               // LDR x4, [x3], #8
+    words[30] = 0xF9400000 | ((low / 8) << 10) | (3 << 5); // LDR x0, [x3, #low]
+
+    // Control flow leaves before the ADD
+    adrp(40, 1);
+    words[41] = 0x94000010;                               // BL
+    words[42] = 0x91000000 | (low << 10) | (1 << 5) | 0;  // ADD x0, x1, #low
+
+    const auto xrefs = hat::find_xrefs_aarch64(data, target);
+    ASSERT_EQ(xrefs.size(), 1);
+    EXPECT_EQ(xrefs[0].instruction, data.data() + 4 * 4);
+    EXPECT_EQ(xrefs[0].kind, hat::xref_kind::adrp_add);
+}
+
+TEST(PointerScanTest, MatchesBruteForce) {
+    // Values clustered around a few bases, so that the ranges and sets have both hits and near misses
+    std::vector<std::uintptr_t> words((1 << 14) + 5);
+    std::minstd_rand rng{42};
+    const std::uintptr_t bases[]{0x1000, 0x7F0000000000 & UINTPTR_MAX, UINTPTR_MAX - 0xFFFF};
+    for (auto& word : words) {
+        word = bases[rng() % std::size(bases)] + rng() % 0x1000;
+    }
+
+    const auto brute_force = [&](const std::span<const std::byte> data, auto&& matches) {
+        std::vector<hat::const_scan_result> results{};
+        const auto begin = reinterpret_cast<std::uintptr_t>(data.data());
+        for (auto i = (sizeof(std::uintptr_t) - begin % sizeof(std::uintptr_t)) % sizeof(std::uintptr_t); i + sizeof(std::uintptr_t) <= data.size(); i += sizeof(std::uintptr_t)) {
+            std::uintptr_t value;
+            std::memcpy(&value, data.data() + i, sizeof(value));
+            if (matches(value)) {
+                results.emplace_back(data.data() + i);
+            }
+        }
+        return results;
+    };
+
+    std::vector<std::uintptr_t> values{};
+    for (std::size_t i = 0; i < 12; i++) {
+        values.push_back(bases[i % std::size(bases)] + rng() % 0x1000);
+    }
+    const std::vector<hat::address_range> ranges{{0x1100, 0x1200}, {0x1800, 0x1801}, {UINTPTR_MAX - 0x8000, UINTPTR_MAX}};
+
+    const auto bytes = std::as_bytes(std::span{words});
+    for (const auto data : {bytes, bytes.subspan(3, bytes.size() - 7)}) {
+        EXPECT_EQ(hat::find_pointers(data, values[0]), brute_force(data, [&](auto v) { return v == values[0]; }));
+        for (const std::size_t count : {2, 4, 12}) {
+            std::vector<std::uintptr_t> set(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(count));
+            std::ranges::sort(set);
+            EXPECT_EQ(hat::find_pointers(data, set), brute_force(data, [&](auto v) { return std::ranges::binary_search(set, v); }));
+        }
+        EXPECT_EQ(hat::find_pointers(data, ranges[0]), brute_force(data, [&](auto v) { return ranges[0].contains(v); }));
+        EXPECT_EQ(hat::find_pointers(data, ranges), brute_force(data, [&](auto v) {
+            return std::ranges::any_of(ranges, [&](const auto& range) { return range.contains(v); });
+        }));
+    }
+}
+
+TEST(PeImageTest, SectionsAndRtti) {
+    // A PE32+ image with .text, .rdata, and a .data section with uninitialized data at its end
+    std::vector<std::byte> file(0xA00);
+    const auto put = [&](const std::size_t offset, const auto value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    const auto putString = [&](const std::size_t offset, const std::string_view str) {
+        std::memcpy(file.data() + offset, str.data(), str.size());
+    };
+    constexpr std::uint64_t imageBase = 0x140000000;
+    put(0x00, std::uint16_t{0x5A4D});
+    put(0x3C, std::uint32_t{0x40});
+    put(0x40, std::uint32_t{0x4550});
+    put(0x44, std::uint16_t{0x8664});
+    put(0x46, std::uint16_t{3});
+    put(0x54, std::uint16_t{0xF0});
+    put(0x58, std::uint16_t{0x20B});
+    put(0x58 + 24, imageBase);
+    put(0x58 + 60, std::uint32_t{0x200});
+    const auto putSection = [&](const std::size_t index, const std::string_view name, const std::uint32_t virtualAddress,
+        const std::uint32_t virtualSize, const std::uint32_t rawOffset, const std::uint32_t rawSize, const std::uint32_t characteristics) {
+        const auto header = 0x148 + index * 40;
+        putString(header, name);
+        put(header + 8, virtualSize);
+        put(header + 12, virtualAddress);
+        put(header + 16, rawSize);
+        put(header + 20, rawOffset);
+        put(header + 36, characteristics);
+    };
+    putSection(0, ".text", 0x1000, 0x180, 0x200, 0x200, 0x60000020);
+    putSection(1, ".rdata", 0x2000, 0x400, 0x400, 0x400, 0x40000040);
+    putSection(2, ".data", 0x3000, 0x800, 0x800, 0x200, 0xC0000040);
+
+    // Type descriptors for a class and a struct, and a decoy which isn't referenced by a locator
+    putString(0x800 + 0x20, ".?AVFoo@@");
+    putString(0x800 + 0x50, ".?AUBar@@");
+    putString(0x800 + 0x80, ".?AVBaz@@");
+
+    // Complete object locators, the second one is for a secondary vtable of Foo
+    const auto putLocator = [&](const std::uint32_t rva, const std::uint32_t offset, const std::uint32_t typeDescriptor) {
+        const auto fileOffset = 0x400 + (rva - 0x2000);
+        put(fileOffset, std::uint32_t{1});
+        put(fileOffset + 4, offset);
+        put(fileOffset + 12, typeDescriptor);
+        put(fileOffset + 20, rva);
+    };
+    putLocator(0x2100, 0, 0x3010);
+    putLocator(0x2120, 8, 0x3010);
+    putLocator(0x2140, 0, 0x3040);
+    put(0x400 + 0x178, imageBase + 0x2120);
+    put(0x400 + 0x180, imageBase + 0x2100);
+    put(0x400 + 0x1C0, imageBase + 0x2140);
+
+    const auto image = hat::pe_image::from_bytes(file);
+    ASSERT_TRUE(image.has_value());
+    EXPECT_TRUE(image->is_64bit());
+    EXPECT_EQ(image->image_base(), imageBase);
+    ASSERT_EQ(image->sections().size(), 3);
+    EXPECT_EQ(image->sections()[0].name, ".text");
+    EXPECT_EQ(image->sections()[0].protection, hat::protection::Read | hat::protection::Execute);
+    EXPECT_EQ(image->get_section_data(".text").size(), 0x180);
+    EXPECT_EQ(image->get_section_data(".data").data(), file.data() + 0x800);
+    EXPECT_EQ(image->get_section_data(".data").size(), 0x200);
+    EXPECT_TRUE(image->get_section_data(".bss").empty());
+
+    EXPECT_EQ(image->rva_to_offset(0x40), 0x40);
+    EXPECT_EQ(image->rva_to_offset(0x3010), 0x810);
+    EXPECT_EQ(image->rva_to_offset(0x3300), std::nullopt); // Uninitialized
+    EXPECT_EQ(image->rva_to_offset(0x1180), std::nullopt); // Padding
+    EXPECT_EQ(image->offset_to_rva(0x810), 0x3010);
+    EXPECT_EQ(image->offset_to_rva(0x390), std::nullopt);
+
+    const auto name = hat::find_pattern(hat::parse_signature("2E 3F 41 55").value(), ".data", *image);
+    ASSERT_TRUE(name.has_result());
+    EXPECT_EQ(image->rva_of(name.get()), 0x3050);
+
+    const hat::msvc_rtti_index index{*image};
+    EXPECT_EQ(index.size(), 3);
+    const auto foo = index.find(".?AVFoo@@");
+    ASSERT_TRUE(foo.has_value());
+    EXPECT_EQ(image->rva_of(foo->type_descriptor), 0x3010);
+    EXPECT_EQ(image->rva_of(foo->complete_object_locator), 0x2100);
+    EXPECT_EQ(image->rva_of(foo->vtable), 0x2188);
+    EXPECT_EQ(image->rva_of(index.find_vtable(".?AUBar@@").get()), 0x21C8);
+    EXPECT_EQ(index.find_vtable(".?AVBaz@@").get(), nullptr);
+    EXPECT_FALSE(index.find(".?AVQux@@").has_value());
+
+    file[0x40] = std::byte{};
+    EXPECT_FALSE(hat::pe_image::from_bytes(file).has_value());
+    EXPECT_FALSE(hat::pe_image::from_bytes({}).has_value());
+}
+
+TEST(ElfImageTest, CoreSegments) {
+    // A core file with a mapping which is partially dumped, and one which isn't dumped at all
+    std::vector<std::byte> file(0x3000);
+    const auto put = [&](const std::size_t offset, const auto value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    put(0x00, std::array<std::uint8_t, 8>{0x7F, 'E', 'L', 'F', 2, 1, 1, 0});
+    put(0x10, std::uint16_t{4});  // ET_CORE
+    put(0x12, std::uint16_t{62}); // EM_X86_64
+    put(0x20, std::uint64_t{0x40});
+    put(0x36, std::uint16_t{56});
+    put(0x38, std::uint16_t{3});
+    const auto putSegment = [&](const std::size_t index, const std::uint32_t type, const std::uint32_t flags,
+        const std::uint64_t offset, const std::uint64_t address, const std::uint64_t fileSize, const std::uint64_t memorySize) {
+        const auto header = 0x40 + index * 56;
+        put(header, type);
+        put(header + 4, flags);
+        put(header + 8, offset);
+        put(header + 16, address);
+        put(header + 32, fileSize);
+        put(header + 40, memorySize);
+    };
+    putSegment(0, 4, 0, 0x200, 0, 0x100, 0); // PT_NOTE
+    putSegment(1, 1, 5, 0x1000, 0x7F0000001000, 0x1000, 0x3000);
+    putSegment(2, 1, 6, 0x2000, 0x7F0000010000, 0, 0x1000);
+    put(0x1800, std::array<std::uint8_t, 8>{0x48, 0x89, 0x5C, 0x24, 0x08, 0x57, 0x48, 0x83});
+
+    const auto image = hat::elf_image::from_bytes(file);
+    ASSERT_TRUE(image.has_value());
+    EXPECT_EQ(image->type(), hat::elf_type::core);
+    EXPECT_EQ(image->machine(), 62);
+    EXPECT_TRUE(image->is_64bit());
+    EXPECT_TRUE(image->sections().empty());
+    ASSERT_EQ(image->segments().size(), 2);
+    EXPECT_EQ(image->segments()[0].virtual_address, 0x7F0000001000);
+    EXPECT_EQ(image->segments()[0].memory_size, 0x3000);
+    EXPECT_EQ(image->segments()[0].data.data(), file.data() + 0x1000);
+    EXPECT_EQ(image->segments()[0].data.size(), 0x1000);
+    EXPECT_EQ(image->segments()[0].protection, hat::protection::Read | hat::protection::Execute);
+    EXPECT_TRUE(image->segments()[1].data.empty());
+
+    EXPECT_EQ(image->address_to_offset(0x7F0000001800), 0x1800);
+    EXPECT_EQ(image->address_to_offset(0x7F0000002800), std::nullopt); // Not dumped
+    EXPECT_EQ(image->address_to_offset(0x7F0000010000), std::nullopt);
+    EXPECT_EQ(image->offset_to_address(0x1FFF), 0x7F0000001FFF);
+    EXPECT_EQ(image->offset_to_address(0x200), std::nullopt);
+
+    const auto signature = hat::parse_signature("48 89 5C 24 ? 57").value();
+    std::vector<std::uint64_t> addresses{};
+    image->for_each_segment([&](const auto data, const auto) {
+        if (const auto result = hat::find_pattern(data, signature); result.has_result()) {
+            addresses.push_back(image->address_of(result.get()).value());
+        }
+        return true;
+    });
+    EXPECT_EQ(addresses, std::vector<std::uint64_t>{0x7F0000001800});
+
+    file[0x05] = std::byte{2}; // Big endian
+    EXPECT_FALSE(hat::elf_image::from_bytes(file).has_value());
+    EXPECT_FALSE(hat::elf_image::from_bytes(std::span{file}.first(0x20)).has_value());
+}
+
+TEST(ElfImageTest, ExtendedCounts) {
+    // A core file whose program header count, section count and string table index are in section header 0
+    std::vector<std::byte> file(0x3000);
+    const auto put = [&](const std::size_t offset, const auto value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    put(0x00, std::array<std::uint8_t, 8>{0x7F, 'E', 'L', 'F', 2, 1, 1, 0});
+    put(0x10, std::uint16_t{4});  // ET_CORE
+    put(0x12, std::uint16_t{62}); // EM_X86_64
+    put(0x20, std::uint64_t{0x40});
+    put(0x28, std::uint64_t{0x400});
+    put(0x36, std::uint16_t{56});
+    put(0x38, std::uint16_t{0xFFFF}); // PN_XNUM
+    put(0x3A, std::uint16_t{64});
+    put(0x3C, std::uint16_t{0});
+    put(0x3E, std::uint16_t{0xFFFF}); // SHN_XINDEX
+    for (std::size_t i = 0; i < 2; i++) {
+        const auto header = 0x40 + i * 56;
+        put(header, std::uint32_t{1}); // PT_LOAD
+        put(header + 4, std::uint32_t{i == 0 ? 4u : 6u});
+        put(header + 8, std::uint64_t{0x1000 + i * 0x1000});
+        put(header + 16, std::uint64_t{0x7F0000000000 + i * 0x100000});
+        put(header + 32, std::uint64_t{0x1000});
+        put(header + 40, std::uint64_t{0x1000});
+    }
+    const auto putSection = [&](const std::size_t index, const std::uint32_t name, const std::uint32_t type,
+        const std::uint64_t offset, const std::uint64_t size, const std::uint32_t link, const std::uint32_t info) {
+        const auto header = 0x400 + index * 64;
+        put(header, name);
+        put(header + 4, type);
+        put(header + 24, offset);
+        put(header + 32, size);
+        put(header + 40, link);
+        put(header + 44, info);
+    };
+    putSection(0, 0, 0, 0, 3, 2, 2); // 3 sections, strings in section 2, 2 program headers
+    putSection(1, 1, 7, 0x300, 0x20, 0, 0);
+    putSection(2, 7, 3, 0x380, 17, 0, 0);
+    put(0x380, std::array<char, 17>{'\0', 'n', 'o', 't', 'e', '0', '\0', '.', 's', 'h', 's', 't', 'r', 't', 'a', 'b', '\0'});
+
+    const auto image = hat::elf_image::from_bytes(file);
+    ASSERT_TRUE(image.has_value());
+    ASSERT_EQ(image->segments().size(), 2);
+    EXPECT_EQ(image->segments()[1].virtual_address, 0x7F0000100000);
+    EXPECT_EQ(image->segments()[1].protection, hat::protection::Read | hat::protection::Write);
+    ASSERT_EQ(image->sections().size(), 2);
+    EXPECT_EQ(image->sections()[0].name, "note0");
+    EXPECT_EQ(image->sections()[1].name, ".shstrtab");
+    EXPECT_EQ(image->get_section_data("note0").data(), file.data() + 0x300);
+
+    // A section table which runs past the end of the file is dropped, the segments are still usable
+    putSection(0, 0, 0, 0, 0x1000, 2, 2);
+    const auto truncated = hat::elf_image::from_bytes(file);
+    ASSERT_TRUE(truncated.has_value());
+    EXPECT_TRUE(truncated->sections().empty());
+    EXPECT_EQ(truncated->segments().size(), 2);
+}
+
+TEST(ElfImageTest, Class32) {
+    // A 32-bit shared object with a single loaded .text section
+    std::vector<std::byte> file(0x2000);
+    const auto put = [&](const std::size_t offset, const auto value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    put(0x00, std::array<std::uint8_t, 8>{0x7F, 'E', 'L', 'F', 1, 1, 1, 0});
+    put(0x10, std::uint16_t{3}); // ET_DYN
+    put(0x12, std::uint16_t{3}); // EM_386
+    put(0x1C, std::uint32_t{0x34});
+    put(0x20, std::uint32_t{0x200});
+    put(0x2A, std::uint16_t{32});
+    put(0x2C, std::uint16_t{1});
+    put(0x2E, std::uint16_t{40});
+    put(0x30, std::uint16_t{3});
+    put(0x32, std::uint16_t{2});
+
+    put(0x34, std::uint32_t{1}); // PT_LOAD
+    put(0x38, std::uint32_t{0x1000});
+    put(0x3C, std::uint32_t{0x1000});
+    put(0x44, std::uint32_t{0x100});
+    put(0x48, std::uint32_t{0x100});
+    put(0x4C, std::uint32_t{5});
+
+    const auto putSection = [&](const std::size_t index, const std::uint32_t name, const std::uint32_t type, const std::uint32_t flags,
+        const std::uint32_t address, const std::uint32_t offset, const std::uint32_t size) {
+        const auto header = 0x200 + index * 40;
+        put(header, name);
+        put(header + 4, type);
+        put(header + 8, flags);
+        put(header + 12, address);
+        put(header + 16, offset);
+        put(header + 20, size);
+    };
+    putSection(1, 1, 1, 6, 0x1000, 0x1000, 0x100); // SHF_ALLOC | SHF_EXECINSTR
+    putSection(2, 7, 3, 0, 0, 0x300, 17);
+    put(0x300, std::array<char, 17>{'\0', '.', 't', 'e', 'x', 't', '\0', '.', 's', 'h', 's', 't', 'r', 't', 'a', 'b', '\0'});
+    put(0x1010, std::array<std::uint8_t, 6>{0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC});
+
+    const auto image = hat::elf_image::from_bytes(file);
+    ASSERT_TRUE(image.has_value());
+    EXPECT_FALSE(image->is_64bit());
+    EXPECT_EQ(image->type(), hat::elf_type::shared_object);
+    EXPECT_EQ(image->machine(), 3);
+    ASSERT_EQ(image->segments().size(), 1);
+    EXPECT_EQ(image->segments()[0].virtual_address, 0x1000);
+    ASSERT_EQ(image->sections().size(), 2);
+    EXPECT_EQ(image->sections()[0].name, ".text");
+    EXPECT_EQ(image->sections()[0].virtual_address, 0x1000);
+    EXPECT_EQ(image->sections()[0].protection, hat::protection::Read | hat::protection::Execute);
+
+    const auto result = hat::find_pattern(hat::parse_signature("55 89 E5 53").value(), ".text", *image);
+    ASSERT_TRUE(result.has_result());
+    EXPECT_EQ(image->address_of(result.get()), 0x1010);
+}